@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 Phosh Developers
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# Compare the startup of two builds of the tour, e.g. one configured
+# with -Draster-images=enabled and one with -Draster-images=disabled
+# or builds of two different commits. Runs each build's phosh-tour
+# alternately in the same environment the benchmarks use and prints
+# the median wall clock time and the median of every startup timing
+# mark both builds recorded.
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def build_env(build_dir, pages_dir):
+    env = dict(os.environ)
+    env.update({
+        'GSETTINGS_SCHEMA_DIR': os.path.join(build_dir, 'data'),
+        'PHOSH_TOUR_BUNDLES_DIR': os.path.join(build_dir, 'data', 'pages'),
+        'PHOSH_TOUR_PAGES_DIR': pages_dir,
+        'GSETTINGS_BACKEND': 'memory',
+        'GSK_RENDERER': 'cairo',
+        'GDK_BACKEND': 'x11',
+        'NO_AT_BRIDGE': '1',
+        'PHOSH_TOUR_TIMINGS': '-',
+    })
+    return env
+
+
+def run_once(build_dir, args, env, xvfb_run):
+    cmd = [os.path.join(build_dir, 'src', 'phosh-tour')] + args
+    if xvfb_run:
+        cmd = [xvfb_run, '-a', '-s', '-noreset'] + cmd
+
+    start = time.perf_counter()
+    proc = subprocess.run(cmd, env=env, check=True, stdout=subprocess.PIPE, text=True)
+    elapsed = time.perf_counter() - start
+
+    marks = {'wall-clock': elapsed * 1000}
+    try:
+        timings = json.loads(proc.stdout)
+    except json.JSONDecodeError:
+        # Builds without timings only have the wall clock time
+        return marks
+
+    for mark in timings['marks']:
+        marks[mark['name']] = mark['usec'] / 1000
+    return marks
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare the startup of two builds')
+    parser.add_argument('--runs', type=int, default=10, help='Runs per build')
+    parser.add_argument('--xvfb-run', help='Run under xvfb-run, e.g. for CI')
+    parser.add_argument('before', help='Build directory of the baseline')
+    parser.add_argument('after', help='Build directory of the change')
+    parser.add_argument('args', nargs='*', default=['--benchmark'],
+                        help='Arguments to pass to phosh-tour (default: --benchmark)')
+    args = parser.parse_args()
+
+    results = {args.before: [], args.after: []}
+    with tempfile.TemporaryDirectory() as pages_dir:
+        # Alternate builds so load changes on the machine affect both alike
+        for _ in range(args.runs):
+            for build_dir in results:
+                env = build_env(build_dir, pages_dir)
+                results[build_dir].append(run_once(build_dir, args.args, env, args.xvfb_run))
+
+    names = [name for name in results[args.before][0] if name in results[args.after][0]]
+    print(f'{"mark":<48} {"before-ms":>10} {"after-ms":>10} {"change":>8}')
+    for name in names:
+        before = statistics.median(run[name] for run in results[args.before])
+        after = statistics.median(run[name] for run in results[args.after])
+        change = (after - before) * 100 / before if before else 0
+        print(f'{name:<48} {before:>10.1f} {after:>10.1f} {change:>+7.1f}%')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,318 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 Phosh Developers
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# Compile the tour's pages from the window's template into a GVariant
+# manifest so they can be constructed without parsing XML at runtime.
+# The template is written out again without the pages.
+#
+# The manifest also carries per locale tables of the pages' summaries
+# and explanations with translations and branding already applied.
+# There's no table for the untranslated strings, locales without a
+# table get them translated and branded at runtime.
+
+import argparse
+import os
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+import gi
+gi.require_version('GLib', '2.0')
+from gi.repository import GLib  # noqa: E402
+
+MANIFEST_VERSION = 3
+# (version,
+#  [(type, page-id, image-uri, summary, explanation, widget-ui, [compatibles])],
+#  {locale: [(summary, explanation)]})
+MANIFEST_TYPE = '(ua(ssssssas)a{sa(ss)})'
+PAGE_TYPES = ('PtPage', 'PtHwPage')
+
+
+def parse_type(typestr, pos=0):
+    """Parse a single GVariant type at pos, return (type, next_pos)"""
+    c = typestr[pos]
+    if c in 'bysuit':
+        return c, pos + 1
+    if c == 'a':
+        elem, pos = parse_type(typestr, pos + 1)
+        return ('a', elem), pos
+    if c in '({':
+        members = []
+        pos += 1
+        while typestr[pos] not in ')}':
+            member, pos = parse_type(typestr, pos)
+            members.append(member)
+        return ('(', tuple(members)), pos + 1
+    raise ValueError(f"Unsupported type '{c}' in {typestr}")
+
+
+FIXED = {'b': (1, '<B'), 'y': (1, '<B'), 'i': (4, '<i'), 'u': (4, '<I'), 't': (8, '<Q')}
+
+
+def alignment(t):
+    if t in FIXED:
+        return FIXED[t][0]
+    if t == 's':
+        return 1
+    if t[0] == 'a':
+        return alignment(t[1])
+    return max([alignment(m) for m in t[1]] + [1])
+
+
+def fixed_size(t):
+    if t in FIXED:
+        return FIXED[t][0]
+    if t == 's' or t[0] == 'a':
+        return None
+    size = 0
+    for m in t[1]:
+        msize = fixed_size(m)
+        if msize is None:
+            return None
+        size = pad_to(size, alignment(m)) + msize
+    return max(pad_to(size, alignment(t)), 1)
+
+
+def pad_to(n, align):
+    return (n + align - 1) // align * align
+
+
+def append_offsets(body, offsets):
+    if not offsets:
+        return bytes(body)
+    for size, fmt in ((1, '<B'), (2, '<H'), (4, '<I'), (8, '<Q')):
+        if len(body) + size * len(offsets) < 1 << (8 * size):
+            break
+    for offset in offsets:
+        body += struct.pack(fmt, offset)
+    return bytes(body)
+
+
+def serialize(t, value):
+    """Serialize value as GVariant of type t in little endian byte order"""
+    if t in FIXED:
+        return struct.pack(FIXED[t][1], int(value))
+    if t == 's':
+        return value.encode('utf-8') + b'\0'
+    if t[0] == 'a':
+        body = bytearray()
+        offsets = []
+        for elem in value:
+            body += b'\0' * (pad_to(len(body), alignment(t[1])) - len(body))
+            body += serialize(t[1], elem)
+            offsets.append(len(body))
+        if fixed_size(t[1]) is not None:
+            return bytes(body)
+        return append_offsets(body, offsets)
+
+    body = bytearray()
+    offsets = []
+    members = t[1]
+    for i, (member, v) in enumerate(zip(members, value)):
+        body += b'\0' * (pad_to(len(body), alignment(member)) - len(body))
+        body += serialize(member, v)
+        if fixed_size(member) is None and i != len(members) - 1:
+            offsets.append(len(body))
+    size = fixed_size(t)
+    if size is not None:
+        return bytes(body) + b'\0' * (size - len(body))
+    return append_offsets(body, offsets[::-1])
+
+
+def check_serialized(data, value):
+    """Check that GLib reads back value in normal form from data"""
+    if sys.byteorder != 'little':
+        # GLib reads the data in host byte order
+        return True
+
+    variant = GLib.Variant.new_from_bytes(GLib.VariantType.new(MANIFEST_TYPE),
+                                          GLib.Bytes.new(data), False)
+    if not variant.is_normal_form():
+        print('Page manifest is not in GVariant normal form', file=sys.stderr)
+        return False
+
+    version, pages, tables = variant.unpack()
+    expected = (value[0], [tuple(p[:-1]) + (list(p[-1]),) for p in value[1]], dict(value[2]))
+    if (version, [tuple(p) for p in pages], tables) != expected:
+        print('Page manifest does not round trip through GLib', file=sys.stderr)
+        return False
+
+    return True
+
+
+PO_ESCAPES = {'n': '\n', 't': '\t', 'r': '\r', '"': '"', '\\': '\\'}
+
+
+def po_unquote(line):
+    s = line.strip()[1:-1]
+    out = []
+    i = 0
+    while i < len(s):
+        if s[i] == '\\' and i + 1 < len(s):
+            out.append(PO_ESCAPES.get(s[i + 1], s[i + 1]))
+            i += 2
+        else:
+            out.append(s[i])
+            i += 1
+    return ''.join(out)
+
+
+def parse_po(path):
+    """Minimal PO parser returning the non fuzzy msgid -> msgstr mapping"""
+    catalog = {}
+    entry = {}
+    key = None
+    fuzzy = False
+
+    def flush():
+        if entry.get('msgid') and entry.get('msgstr') and not fuzzy \
+           and 'msgctxt' not in entry:
+            catalog[entry['msgid']] = entry['msgstr']
+
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                flush()
+                entry, key, fuzzy = {}, None, False
+            elif line.startswith('#,'):
+                fuzzy = fuzzy or 'fuzzy' in line
+            elif line.startswith('#'):
+                continue
+            elif line.startswith('"') and key:
+                entry[key] += po_unquote(line)
+            else:
+                key, _, value = line.partition(' ')
+                entry[key] = po_unquote(value)
+    flush()
+    return catalog
+
+
+def brand(s, args):
+    return s.replace('@BRAND@', args.brand).replace('@VENDOR@', args.vendor).replace('@URL@', args.url)
+
+
+def locale_tables(pages, args):
+    tables = {}
+
+    if not args.po_dir:
+        return tables
+
+    with open(os.path.join(args.po_dir, 'LINGUAS'), encoding='utf-8') as f:
+        linguas = [lang for line in f for lang in line.split('#')[0].split()]
+
+    for lang in linguas:
+        catalog = parse_po(os.path.join(args.po_dir, f'{lang}.po'))
+        tables[lang] = [(brand(catalog.get(p['summary'], p['summary']), args),
+                         brand(catalog.get(p['explanation'], p['explanation']), args))
+                        for p in pages]
+    return tables
+
+
+def find_carousel(root):
+    for obj in root.iter('object'):
+        if obj.get('id') == 'main_carousel':
+            return obj
+    raise ValueError('No main_carousel in template')
+
+
+def widget_ui(prop):
+    obj = prop.find('object')
+    if obj is None:
+        return ''
+    if obj.get('id') is None:
+        obj.set('id', 'widget')
+    return '<interface>' + ET.tostring(obj, encoding='unicode') + '</interface>'
+
+
+def parse_page(obj):
+    page = {
+        'type': obj.get('class'),
+        'page-id': '',
+        'image-uri': '',
+        'summary': '',
+        'explanation': '',
+        'widget': '',
+        'compatibles': [],
+    }
+
+    for prop in obj.findall('property'):
+        name = prop.get('name')
+        if name == 'widget':
+            page['widget'] = widget_ui(prop)
+        elif name == 'compatibles':
+            page['compatibles'] = [c.strip() for c in prop.text.split('\n') if c.strip()]
+        elif name in page:
+            page[name] = prop.text or ''
+        else:
+            raise ValueError(f"Unknown page property '{name}'")
+    if not page['page-id']:
+        raise ValueError(f"Page '{page['image-uri']}' has no page-id")
+    return page
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile tour pages')
+    parser.add_argument('--template', required=True, help='The window template')
+    parser.add_argument('--template-output', required=True,
+                        help='Where to write the template without pages')
+    parser.add_argument('--manifest-output', required=True,
+                        help='Where to write the page manifest')
+    parser.add_argument('--builder-output',
+                        help='Where to write the pages as plain GtkBuilder file')
+    parser.add_argument('--po-dir', help='Directory with LINGUAS and the translations')
+    parser.add_argument('--brand', default='', help='The value for @BRAND@')
+    parser.add_argument('--vendor', default='', help='The value for @VENDOR@')
+    parser.add_argument('--url', default='', help='The value for @URL@')
+    args = parser.parse_args()
+
+    tree = ET.parse(args.template)
+    carousel = find_carousel(tree.getroot())
+
+    pages = []
+    builder_pages = []
+    for child in carousel.findall('child'):
+        obj = child.find('object')
+        if obj is None or obj.get('class') not in PAGE_TYPES:
+            continue
+        builder_pages.append(ET.tostring(child, encoding='unicode'))
+        pages.append(parse_page(obj))
+        carousel.remove(child)
+
+    if not pages:
+        print(f'No pages found in {args.template}', file=sys.stderr)
+        return 1
+
+    ids = [p['page-id'] for p in pages]
+    if len(set(ids)) != len(ids):
+        print(f'Duplicate page ids in {args.template}', file=sys.stderr)
+        return 1
+
+    manifest = (MANIFEST_VERSION,
+                [(p['type'], p['page-id'], p['image-uri'], p['summary'], p['explanation'],
+                  p['widget'], p['compatibles']) for p in pages],
+                sorted(locale_tables(pages, args).items()))
+    data = serialize(parse_type(MANIFEST_TYPE)[0], manifest)
+    # The manifest is written by hand so make sure GLib agrees with it
+    if not check_serialized(data, manifest):
+        return 1
+    with open(args.manifest_output, 'wb') as f:
+        f.write(data)
+
+    tree.write(args.template_output, encoding='UTF-8', xml_declaration=True)
+
+    if args.builder_output:
+        with open(args.builder_output, 'w', encoding='utf-8') as f:
+            f.write('<?xml version="1.0" encoding="UTF-8"?>\n<interface>\n'
+                    '<object class="AdwCarousel" id="main_carousel">\n')
+            f.write('\n'.join(builder_pages))
+            f.write('</object>\n</interface>\n')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 Phosh Developers
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# Compose the frames of an animated illustration into a single SVG
+# sprite sheet so it can be pre-rendered with rsvg-convert. Only the
+# horizontal band of the illustration that changes is animated, the
+# frames of that band are stacked vertically. Also writes the
+# metadata the runtime needs to play the frames back.
+#
+# The animation is described in a key file next to the SVG:
+#
+#   [Animation]
+#   # Id of the element to animate
+#   Element=touch
+#   # The changing band in pixels of the 1x raster
+#   Top=300
+#   Height=100
+#   Frames=10
+#   # Duration of one loop in milliseconds
+#   Duration=1200
+#   # Start and end values, in the element's coordinates
+#   Translate=0,0;0,-40
+#   Scale=1;2
+#   Origin=10,10
+#   Opacity=1;0
+
+import argparse
+import configparser
+import copy
+import sys
+import xml.etree.ElementTree as ET
+
+SVG_NS = 'http://www.w3.org/2000/svg'
+XLINK_NS = 'http://www.w3.org/1999/xlink'
+GROUP = 'Animation'
+
+
+def parse_pair(value):
+    return tuple(float(v) for v in value.split(','))
+
+
+def parse_range(spec, key, parse, default):
+    if key not in spec:
+        return default, default
+    start, end = spec[key].split(';')
+    return parse(start), parse(end)
+
+
+def lerp(start, end, t):
+    if isinstance(start, tuple):
+        return tuple(lerp(s, e, t) for s, e in zip(start, end))
+    return start + (end - start) * t
+
+
+def ease_in_out(t):
+    return t * t * (3 - 2 * t)
+
+
+def find_element(root, element_id):
+    for elem in root.iter():
+        if elem.get('id') == element_id:
+            return elem
+    return None
+
+
+def frame_transform(spec, t):
+    translate = lerp(*parse_range(spec, 'Translate', parse_pair, (0.0, 0.0)), t)
+    scale = lerp(*parse_range(spec, 'Scale', float, 1.0), t)
+    ox, oy = parse_pair(spec.get('Origin', '0,0'))
+
+    return (f'translate({translate[0]:.3f} {translate[1]:.3f}) '
+            f'translate({ox:.3f} {oy:.3f}) scale({scale:.4f}) translate({-ox:.3f} {-oy:.3f})')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compose SVG sprite sheets')
+    parser.add_argument('--spec', required=True, help='The animation description')
+    parser.add_argument('--output', required=True, help='Where to write the sprite sheet SVG')
+    parser.add_argument('--metadata', required=True, help='Where to write the playback metadata')
+    parser.add_argument('--width', type=int, default=240, help='Width of the 1x raster')
+    parser.add_argument('svg', help='The illustration')
+    args = parser.parse_args()
+
+    config = configparser.ConfigParser()
+    config.optionxform = str
+    config.read(args.spec)
+    spec = config[GROUP]
+
+    frames = int(spec['Frames'])
+    top = int(spec['Top'])
+    height = int(spec['Height'])
+    duration = int(spec['Duration'])
+
+    ET.register_namespace('', SVG_NS)
+    ET.register_namespace('xlink', XLINK_NS)
+    source = ET.parse(args.svg).getroot()
+
+    vb_x, vb_y, vb_w, vb_h = (float(v) for v in source.get('viewBox').split())
+    # User units per pixel of the 1x raster
+    unit = vb_w / args.width
+    if find_element(source, spec['Element']) is None:
+        print(f"No element '{spec['Element']}' in {args.svg}", file=sys.stderr)
+        return 1
+
+    sheet = ET.Element(f'{{{SVG_NS}}}svg', {
+        'width': str(args.width),
+        'height': str(height * frames),
+        'viewBox': f'0 0 {args.width} {height * frames}',
+    })
+
+    for i in range(frames):
+        t = ease_in_out(i / max(frames - 1, 1))
+        frame = copy.deepcopy(source)
+        elem = find_element(frame, spec['Element'])
+
+        transform = frame_transform(spec, t)
+        if elem.get('transform'):
+            transform = elem.get('transform') + ' ' + transform
+        elem.set('transform', transform)
+        elem.set('opacity', f'{lerp(*parse_range(spec, "Opacity", float, 1.0), t):.3f}')
+
+        # Each frame shows only the band of the illustration
+        frame.attrib = {
+            'x': '0',
+            'y': str(i * height),
+            'width': str(args.width),
+            'height': str(height),
+            'viewBox': f'{vb_x} {vb_y + top * unit:.4f} {vb_w} {height * unit:.4f}',
+        }
+        sheet.append(frame)
+
+    ET.ElementTree(sheet).write(args.output, encoding='UTF-8', xml_declaration=True)
+
+    with open(args.metadata, 'w') as f:
+        f.write(f'[{GROUP}]\n'
+                f'Frames={frames}\n'
+                f'Top={top}\n'
+                f'Height={height}\n'
+                f'Duration={duration}\n')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2026 Phosh Developers
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# Normalize and minify the page illustrations before they're compiled
+# into resources: drop editor metadata, unreferenced ids, whitespace
+# and excess number precision. Writes a per asset report of the bytes
+# saved and the measured parse and rasterization cost and warns about
+# assets exceeding the cost budget.
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+import xml.etree.ElementTree as ET
+
+SVG_NS = 'http://www.w3.org/2000/svg'
+XLINK_NS = 'http://www.w3.org/1999/xlink'
+# Namespaces only used by editors
+EDITOR_NS = (
+    'http://sodipodi.sourceforge.net/DTD/sodipodi-0.dtd',
+    'http://www.inkscape.org/namespaces/inkscape',
+    'http://www.w3.org/1999/02/22-rdf-syntax-ns#',
+    'http://creativecommons.org/ns#',
+    'http://purl.org/dc/elements/1.1/',
+)
+# Elements where whitespace is significant
+TEXT_ELEMENTS = ('text', 'tspan', 'textPath')
+# Rounding matrix factors would scale errors up, keep them as is
+TRANSFORM_ATTRS = ('transform', 'gradientTransform', 'patternTransform')
+
+NUMBER_RE = re.compile(r'-?\d*\.\d+')
+ID_REF_RE = re.compile(r'url\(\s*#([^)\s]+)\s*\)')
+COST_RUNS = 3
+
+
+def split_tag(name):
+    if name.startswith('{'):
+        ns, local = name[1:].split('}', 1)
+        return ns, local
+    return None, name
+
+
+def round_numbers(value, precision):
+    def repl(match):
+        num = float(match.group(0))
+        out = f'{round(num, precision):.{precision}f}'.rstrip('0').rstrip('.')
+        if out in ('-0', ''):
+            out = '0'
+        out = re.sub(r'^(-?)0\.', r'\1.', out)
+        # Don't merge with a following number like '.5' in path data
+        if '.' not in out and value[match.end():match.end() + 1] == '.':
+            out += ' '
+        return out
+
+    return NUMBER_RE.sub(repl, value)
+
+
+def minify_style(style):
+    props = []
+    for prop in style.split(';'):
+        if ':' not in prop:
+            continue
+        name, value = (p.strip() for p in prop.split(':', 1))
+        if name.startswith('-inkscape-'):
+            continue
+        props.append(f'{name}:{value}')
+    return ';'.join(props)
+
+
+def referenced_ids(root):
+    ids = set()
+    for elem in root.iter():
+        for name, value in elem.attrib.items():
+            ids.update(ID_REF_RE.findall(value))
+            if split_tag(name)[1] == 'href' and value.startswith('#'):
+                ids.add(value[1:])
+    return ids
+
+
+def strip_elements(parent):
+    for child in list(parent):
+        ns, local = split_tag(child.tag)
+        if ns in EDITOR_NS or (ns == SVG_NS and local == 'metadata'):
+            parent.remove(child)
+        else:
+            strip_elements(child)
+
+
+def minify(data, precision):
+    root = ET.fromstring(data)
+    strip_elements(root)
+    used_ids = referenced_ids(root)
+
+    for elem in root.iter():
+        local = split_tag(elem.tag)[1]
+        for name in list(elem.attrib):
+            ns, attr = split_tag(name)
+            value = elem.attrib[name]
+            if ns in EDITOR_NS:
+                del elem.attrib[name]
+            elif attr == 'id' and value not in used_ids:
+                del elem.attrib[name]
+            elif attr == 'style':
+                elem.attrib[name] = round_numbers(minify_style(value), precision)
+            elif ns != XLINK_NS and attr not in TRANSFORM_ATTRS:
+                elem.attrib[name] = round_numbers(value, precision)
+
+        if local not in TEXT_ELEMENTS:
+            if elem.text is not None and not elem.text.strip():
+                elem.text = None
+            if elem.tail is not None and not elem.tail.strip():
+                elem.tail = None
+
+    # Tags are the only place where ' />' can occur unescaped
+    return ET.tostring(root, encoding='unicode').replace(' />', '/>').encode('utf-8')
+
+
+def measure_cost(path, rsvg_convert):
+    """Best of a few runs in ms, rasterizing if rsvg-convert is available"""
+    best = None
+    for _ in range(COST_RUNS):
+        if rsvg_convert:
+            with tempfile.NamedTemporaryFile(suffix='.png') as out:
+                start = time.perf_counter()
+                subprocess.run([rsvg_convert, '--output', out.name, path], check=True)
+                elapsed = time.perf_counter() - start
+        else:
+            start = time.perf_counter()
+            ET.parse(path)
+            elapsed = time.perf_counter() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best * 1000
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Minify SVG illustrations')
+    parser.add_argument('--output-dir', required=True, help='Where to write the minified SVGs')
+    parser.add_argument('--report', required=True, help='Where to write the report')
+    parser.add_argument('--precision', type=int, default=3,
+                        help='Decimal places to keep in numbers')
+    parser.add_argument('--rsvg-convert', help='rsvg-convert to measure rasterization cost')
+    parser.add_argument('--budget-kb', type=int, default=0,
+                        help='Warn about minified assets larger than this, 0 to disable')
+    parser.add_argument('--budget-ms', type=int, default=0,
+                        help='Warn about assets taking longer to rasterize, 0 to disable')
+    parser.add_argument('svgs', nargs='+', help='The SVGs to minify')
+    args = parser.parse_args()
+
+    ET.register_namespace('', SVG_NS)
+    ET.register_namespace('xlink', XLINK_NS)
+
+    cost = 'rasterize-ms' if args.rsvg_convert else 'parse-ms'
+    lines = [f'{"asset":<24} {"bytes":>8} {"minified":>8} {"saved":>6} {cost:>12}']
+    total_in = total_out = 0
+    for svg in args.svgs:
+        with open(svg, 'rb') as f:
+            data = f.read()
+
+        minified = minify(data, args.precision)
+        output = os.path.join(args.output_dir, os.path.basename(svg))
+        with open(output, 'wb') as f:
+            f.write(minified)
+
+        ms = measure_cost(output, args.rsvg_convert)
+        name = os.path.basename(svg)
+        saved = 100 - len(minified) * 100 // len(data)
+        lines.append(f'{name:<24} {len(data):>8} {len(minified):>8} {saved:>5}% {ms:>12.1f}')
+        total_in += len(data)
+        total_out += len(minified)
+
+        if args.budget_kb and len(minified) > args.budget_kb * 1024:
+            print(f'WARNING: {name} is {len(minified) // 1024} KiB, budget is {args.budget_kb} KiB',
+                  file=sys.stderr)
+        if args.budget_ms and ms > args.budget_ms:
+            print(f'WARNING: {name} takes {ms:.1f}ms, budget is {args.budget_ms}ms',
+                  file=sys.stderr)
+
+    lines.append(f'{"total":<24} {total_in:>8} {total_out:>8} '
+                 f'{100 - total_out * 100 // max(total_in, 1):>5}%')
+
+    with open(args.report, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    sys.exit(main())
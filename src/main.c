@@ -20,6 +20,10 @@
 
 #include "phosh-tour-config.h"
 #include "pt-application.h"
+#include "pt-frame-stats.h"
+#include "pt-memory.h"
+#include "pt-timings.h"
+#include "pt-trace.h"
 
 int
 main (int argc, char *argv[])
@@ -27,6 +31,12 @@ main (int argc, char *argv[])
   g_autoptr (PtApplication) app = NULL;
   int ret;
 
+  PT_TRACE_INIT ();
+  pt_timings_init ();
+  pt_frame_stats_init ();
+  pt_memory_init ();
+  pt_memory_sample (NULL, "startup");
+
   /* Set up gettext translations */
   bindtextdomain (GETTEXT_PACKAGE, LOCALEDIR);
   bind_textdomain_codeset (GETTEXT_PACKAGE, "UTF-8");
@@ -35,5 +45,9 @@ main (int argc, char *argv[])
   app = pt_application_new (PHOSH_TOUR_APP_ID, G_APPLICATION_DEFAULT_FLAGS);
   ret = g_application_run (G_APPLICATION (app), argc, argv);
 
+  pt_timings_dump ();
+  pt_frame_stats_dump ();
+  pt_memory_dump ();
+
   return ret;
 }
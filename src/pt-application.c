@@ -10,16 +10,29 @@
 #include "phosh-tour-config.h"
 
 #include "pt-application.h"
+#include "pt-page-manifest.h"
+#include "pt-page-packs.h"
+#include "pt-pressure.h"
+#include "pt-stamp.h"
+#include "pt-timings.h"
+#include "pt-trace.h"
 #include "pt-window.h"
 
 #include <glib/gi18n.h>
 
 #define DESC _("- A graphical tour introducing your device")
+#define PRESSURE_POLL_INTERVAL_MS 1000
+#define FIRST_IMAGE_TIMEOUT_MS 5000
 
 struct _PtApplication {
   GtkApplication parent_instance;
 
-  gboolean run_once;
+  gboolean benchmark;
+  gboolean low_power;
+  /* The page to start at, from --page */
+  char    *page;
+  /* Set when only pages added since the last run should be shown */
+  GStrv    seen_pages;
 };
 
 G_DEFINE_TYPE (PtApplication, pt_application, ADW_TYPE_APPLICATION)
@@ -30,7 +43,22 @@ static const GOptionEntry entries[] = {
     NULL, "Get the current version", NULL,
   },
   { "run-once", '\0', 0, G_OPTION_ARG_NONE,
-    NULL, "Run the tour only once and then exit", NULL
+    NULL, "Run the tour only once, later only show pages added since", NULL
+  },
+  { "benchmark", '\0', G_OPTION_FLAG_NONE, G_OPTION_ARG_NONE,
+    NULL, "Print startup timings as JSON and exit once the first page's image is shown", NULL
+  },
+  { "low-power", '\0', G_OPTION_FLAG_NONE, G_OPTION_ARG_NONE,
+    NULL, "Switch pages without animations and don't prefetch them", NULL
+  },
+  { "page", '\0', G_OPTION_FLAG_NONE, G_OPTION_ARG_STRING,
+    NULL, "Start the tour at the page with the given id", "ID"
+  },
+  { "defer", '\0', G_OPTION_FLAG_NONE, G_OPTION_ARG_NONE,
+    NULL, "Wait for CPU, IO and memory pressure to settle before showing up", NULL
+  },
+  { "defer-max-wait", '\0', G_OPTION_FLAG_NONE, G_OPTION_ARG_INT,
+    NULL, "Wait at most this many seconds with --defer", "SECONDS"
   },
   G_OPTION_ENTRY_NULL
 };
@@ -46,40 +74,148 @@ pt_application_new (char *application_id, GApplicationFlags flags)
 }
 
 
-static gboolean
-pt_application_check_and_create_run_once (void)
+static GStrv
+get_page_ids (void)
 {
-  g_autofree char *config_path = NULL;
-  g_autoptr(GError) error = NULL;
-  g_autoptr(GFile) file = NULL;
-  g_autoptr(GFileOutputStream) output_stream = NULL;
+  g_autoptr (GError) err = NULL;
+  g_auto (GStrv) builtin_ids = NULL;
 
-  config_path = g_build_filename (g_get_user_config_dir (), "phosh-tour", "run-once", NULL);
-
-  if (g_file_test (config_path, G_FILE_TEST_EXISTS)) {
-    g_debug ("Phosh tour already ran once.");
-    return TRUE;
+  builtin_ids = pt_page_manifest_get_page_ids (&err);
+  if (builtin_ids == NULL) {
+    g_warning ("Failed to get page ids: %s", err->message);
+    return g_new0 (char *, 1);
   }
 
-  if (g_mkdir_with_parents (g_path_get_dirname (config_path), 0755) != 0) {
-    g_warning ("Error creating directory for run-once file.");
-    return FALSE;
-  }
+  return pt_page_packs_get_page_ids ((const char *const *) builtin_ids);
+}
 
-  file = g_file_new_for_path (config_path);
-  output_stream = g_file_create (file, G_FILE_CREATE_NONE, NULL, &error);
-  if (!output_stream) {
-    g_warning ("Error creating run-once file: %s", error->message);
-    return FALSE;
+/*
+ * Checks which pages the user has seen and records the current ones.
+ * Returns %TRUE if there's nothing new to show. Otherwise
+ * seen_pages is set if only new pages should be shown.
+ */
+static gboolean
+pt_application_check_and_create_run_once (PtApplication *self)
+{
+  g_autofree char *path = pt_stamp_get_path ();
+  g_autofree char *version = NULL;
+  g_auto (GStrv) page_ids = get_page_ids ();
+  g_auto (GStrv) seen = NULL;
+  g_auto (GStrv) unseen = NULL;
+  g_autoptr (GStrvBuilder) builder = NULL;
+  g_auto (GStrv) stamp_ids = NULL;
+  g_autoptr (GError) error = NULL;
+
+  if (pt_stamp_load (path, &version, &seen, &error)) {
+    unseen = pt_stamp_get_unseen_pages ((const char *const *) seen,
+                                        (const char *const *) page_ids);
+    if (unseen[0] == NULL) {
+      g_debug ("Phosh tour %s already ran once.", version ?: "(unknown version)");
+      return TRUE;
+    }
+
+    g_debug ("%u page(s) new since tour %s", g_strv_length (unseen),
+             version ?: "(unknown version)");
+    self->seen_pages = g_steal_pointer (&seen);
+  } else if (g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
+    g_debug ("Running Phosh tour for the first time.");
+  } else {
+    g_warning ("Failed to load run-once file: %s", error->message);
   }
-  if (!g_output_stream_close (G_OUTPUT_STREAM (output_stream), NULL, &error)) {
-    g_warning ("Error closing run-once file: %s", error->message);
-    return FALSE;
+  g_clear_error (&error);
+
+  /* Keep the ids of pages that went away so they don't count as new when they return */
+  builder = g_strv_builder_new ();
+  if (self->seen_pages)
+    g_strv_builder_addv (builder, (const char **) self->seen_pages);
+  if (unseen)
+    g_strv_builder_addv (builder, (const char **) unseen);
+  else
+    g_strv_builder_addv (builder, (const char **) page_ids);
+  stamp_ids = g_strv_builder_end (builder);
+
+  if (!pt_stamp_save (path, PHOSH_TOUR_VERSION, (const char *const *) stamp_ids, &error))
+    g_warning ("Error creating run-once file: %s", error->message);
+
+  return FALSE;
+}
+
+
+/*
+ * Waits for the session to finish starting up so we don't compete
+ * with it. This happens before the toolkit is initialized.
+ */
+static void
+pt_application_defer (PtApplication *self, GVariantDict *options)
+{
+  g_autoptr (GSettings) settings = g_settings_new (PHOSH_TOUR_APP_ID);
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+  PtPressure thresholds;
+  guint max_wait;
+  int max_wait_option;
+  gboolean settled;
+
+  thresholds = (PtPressure) {
+    .cpu = g_settings_get_double (settings, "defer-cpu-pressure"),
+    .io = g_settings_get_double (settings, "defer-io-pressure"),
+    .memory = g_settings_get_double (settings, "defer-memory-pressure"),
+  };
+  max_wait = g_settings_get_uint (settings, "defer-max-wait");
+  if (g_variant_dict_lookup (options, "defer-max-wait", "i", &max_wait_option))
+    max_wait = MAX (max_wait_option, 0);
+
+  settled = pt_pressure_wait (pt_pressure_get_default_dir (),
+                              &thresholds,
+                              PRESSURE_POLL_INTERVAL_MS,
+                              max_wait * 1000);
+  if (!settled)
+    g_debug ("Pressure didn't settle within %us, starting anyway", max_wait);
+
+  pt_timings_mark ("deferred");
+  PT_TRACE_MARK (begin, "defer", "%s", settled ? "settled" : "timed out");
+}
+
+
+static gboolean
+on_first_image_timeout (gpointer user_data)
+{
+  g_warning ("First page's image not shown within %dms", FIRST_IMAGE_TIMEOUT_MS);
+  g_application_quit (G_APPLICATION (user_data));
+
+  return G_SOURCE_REMOVE;
+}
+
+
+static void
+on_after_paint (GdkFrameClock *frame_clock, PtApplication *self)
+{
+  if (!pt_timings_has_mark ("first-frame")) {
+    pt_timings_mark ("first-frame");
+    /* E.g. in text only mode there's no image to wait for */
+    if (self->benchmark)
+      g_timeout_add (FIRST_IMAGE_TIMEOUT_MS, on_first_image_timeout, self);
   }
 
-  g_debug ("Running Phosh tour for the first time.");
+  /* Images are decoded in a thread so they usually show up a few frames later */
+  if (!pt_timings_has_mark ("first-image"))
+    return;
 
-  return FALSE;
+  pt_timings_mark ("first-image-frame");
+  g_signal_handlers_disconnect_by_func (frame_clock, on_after_paint, self);
+
+  if (self->benchmark)
+    g_application_quit (G_APPLICATION (self));
+}
+
+
+static void
+pt_application_startup (GApplication *app)
+{
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+
+  G_APPLICATION_CLASS (pt_application_parent_class)->startup (app);
+
+  PT_TRACE_MARK (begin, "application-startup", "toolkit init");
 }
 
 
@@ -88,31 +224,39 @@ pt_application_activate (GApplication *app)
 {
   GtkWindow *window;
   PtApplication *self = PT_APPLICATION (app);
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
 
   g_assert (GTK_IS_APPLICATION (app));
 
-  if (self->run_once) {
-    if (pt_application_check_and_create_run_once ()) {
-      g_debug ("Phosh tour already completed once.");
-      g_application_quit (app);
-      return;
-    } else {
-      g_debug ("Running Phosh tour for the first time.");
-    }
-  }
+  pt_timings_mark ("application-activate");
 
   window = gtk_application_get_active_window (GTK_APPLICATION (app));
-  if (window == NULL)
-    window = g_object_new (PT_TYPE_WINDOW, "application", app, NULL);
+  if (window == NULL) {
+    window = g_object_new (PT_TYPE_WINDOW,
+                           "application", app,
+                           "seen-pages", self->seen_pages,
+                           "low-power", self->low_power,
+                           "initial-page", self->page,
+                           NULL);
+    /* Later activations keep the current page */
+    g_clear_pointer (&self->page, g_free);
+  }
 
   gtk_window_present (window);
+  PT_TRACE_MARK (begin, "application-activate", "present window");
+
+  if (pt_timings_is_enabled ()) {
+    GdkFrameClock *frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (window));
+
+    g_signal_connect (frame_clock, "after-paint", G_CALLBACK (on_after_paint), self);
+  }
 }
 
 
 static int
-pt_application_handle_local_options (GApplication *app, GVariantDict *options)
+handle_local_options (PtApplication *self, GVariantDict *options)
 {
-  PtApplication *self = PT_APPLICATION (app);
+  GApplication *app = G_APPLICATION (self);
 
   if (g_variant_dict_contains (options, "version")) {
     g_print ("%s %s %s\n", PHOSH_TOUR_APP, PHOSH_TOUR_VERSION, DESC);
@@ -120,20 +264,89 @@ pt_application_handle_local_options (GApplication *app, GVariantDict *options)
     return 0;
   }
 
+  if (g_variant_dict_contains (options, "benchmark")) {
+    self->benchmark = TRUE;
+    pt_timings_enable ("-");
+    /* Don't interfere with (or require) a running instance */
+    g_application_set_flags (app, g_application_get_flags (app) | G_APPLICATION_NON_UNIQUE);
+  }
+
+  if (g_variant_dict_contains (options, "low-power"))
+    self->low_power = TRUE;
+
+  g_variant_dict_lookup (options, "page", "s", &self->page);
+
+  /* Decide early so we don't pay for toolkit and display setup just to quit again */
   if (g_variant_dict_contains (options, "run-once")) {
-    self->run_once = TRUE;
-    g_debug ("Running the tour with --run-once option.\n");
+    gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+    gboolean seen;
+
+    g_debug ("Running the tour with --run-once option.");
+    seen = pt_application_check_and_create_run_once (self);
+    PT_TRACE_MARK (begin, "run-once-check", "%s", seen ? "seen" : "first run");
+    if (seen)
+      return 0;
+  }
+
+  /* A running tour doesn't see our options, tell it where to go instead */
+  if (self->page && !(g_application_get_flags (app) & G_APPLICATION_NON_UNIQUE)) {
+    g_autoptr (GError) err = NULL;
+
+    if (!g_application_register (app, NULL, &err)) {
+      g_warning ("Failed to register application: %s", err->message);
+    } else if (g_application_get_is_remote (app)) {
+      GDBusConnection *connection = g_application_get_dbus_connection (app);
+
+      g_action_group_activate_action (G_ACTION_GROUP (app), "goto-page",
+                                      g_variant_new_string (self->page));
+      /* The call is asynchronous, make sure it's sent before we exit */
+      if (connection)
+        g_dbus_connection_flush_sync (connection, NULL, NULL);
+      return 0;
+    }
   }
 
+  if (g_variant_dict_contains (options, "defer") && !self->benchmark)
+    pt_application_defer (self, options);
+
   return G_APPLICATION_CLASS (pt_application_parent_class)->handle_local_options (app, options);
 }
 
 
+static int
+pt_application_handle_local_options (GApplication *app, GVariantDict *options)
+{
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+  int ret;
+
+  ret = handle_local_options (PT_APPLICATION (app), options);
+  PT_TRACE_MARK (begin, "handle-local-options", "%d", ret);
+
+  return ret;
+}
+
+
+static void
+pt_application_finalize (GObject *object)
+{
+  PtApplication *self = PT_APPLICATION (object);
+
+  g_clear_pointer (&self->seen_pages, g_strfreev);
+  g_clear_pointer (&self->page, g_free);
+
+  G_OBJECT_CLASS (pt_application_parent_class)->finalize (object);
+}
+
+
 static void
 pt_application_class_init (PtApplicationClass *klass)
 {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GApplicationClass *app_class = G_APPLICATION_CLASS (klass);
 
+  object_class->finalize = pt_application_finalize;
+
+  app_class->startup = pt_application_startup;
   app_class->activate = pt_application_activate;
   app_class->handle_local_options = pt_application_handle_local_options;
 }
@@ -167,10 +380,32 @@ pt_application_show_about (GSimpleAction *action,
 }
 
 
+static void
+pt_application_goto_page (GSimpleAction *action,
+                          GVariant      *parameter,
+                          gpointer       user_data)
+{
+  PtApplication *self = PT_APPLICATION (user_data);
+  GtkWindow *window = gtk_application_get_active_window (GTK_APPLICATION (self));
+
+  if (window == NULL) {
+    g_free (self->page);
+    self->page = g_variant_dup_string (parameter, NULL);
+    g_application_activate (G_APPLICATION (self));
+    return;
+  }
+
+  gtk_widget_activate_action (GTK_WIDGET (window), "win.goto-page", "s",
+                              g_variant_get_string (parameter, NULL));
+  gtk_window_present (window);
+}
+
+
 static void
 pt_application_init (PtApplication *self)
 {
   g_autoptr (GSimpleAction) about_action = NULL;
+  g_autoptr (GSimpleAction) goto_page_action = NULL;
   g_autoptr (GSimpleAction) quit_action = NULL;
 
   quit_action = g_simple_action_new ("quit", NULL);
@@ -181,6 +416,11 @@ pt_application_init (PtApplication *self)
   g_signal_connect (about_action, "activate", G_CALLBACK (pt_application_show_about), self);
   g_action_map_add_action (G_ACTION_MAP (self), G_ACTION (about_action));
 
+  /* Lets later invocations with --page navigate the running tour */
+  goto_page_action = g_simple_action_new ("goto-page", G_VARIANT_TYPE_STRING);
+  g_signal_connect (goto_page_action, "activate", G_CALLBACK (pt_application_goto_page), self);
+  g_action_map_add_action (G_ACTION_MAP (self), G_ACTION (goto_page_action));
+
   gtk_application_set_accels_for_action (GTK_APPLICATION (self),
                                          "app.quit",
                                          (const char *[]) {
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-compatible-matcher"
+
+#include "phosh-tour-config.h"
+
+#include "pt-compatible-matcher.h"
+
+#include <string.h>
+
+/**
+ * PtCompatibleMatcher:
+ *
+ * Matches device tree compatibles against the compatible patterns of
+ * many rules (e.g. one per hardware specific page) at once.
+ *
+ * A pattern is either an exact compatible like `purism,librem5` or a
+ * prefix ending in `*` like `pine64,*`. Patterns starting with `!`
+ * exclude devices. A rule matches if any of its positive patterns
+ * matches any of the compatibles and none of its negated ones does.
+ * A rule with only negated patterns matches all other devices, a rule
+ * without patterns never matches.
+ *
+ * All rules are compiled into a hash table for exact patterns and a
+ * trie for prefixes so matching takes a single pass over the
+ * compatibles independent of the number of rules.
+ */
+
+typedef struct {
+  guint    rule;
+  gboolean negated;
+} PtCompatibleMatcherEntry;
+
+typedef struct _PtTrieNode PtTrieNode;
+struct _PtTrieNode {
+  char        c;
+  PtTrieNode *child;
+  PtTrieNode *sibling;
+  /* Entries whose prefix ends here */
+  GArray     *entries;
+};
+
+typedef struct {
+  gboolean has_positive;
+  gboolean has_negative;
+  gboolean positive;
+  gboolean negative;
+} PtCompatibleMatcherRule;
+
+struct _PtCompatibleMatcher {
+  /* Exact pattern → GArray of entries */
+  GHashTable *exact;
+  PtTrieNode *prefixes;
+  GArray     *rules;
+};
+
+
+static void
+pt_trie_node_free (PtTrieNode *node)
+{
+  while (node) {
+    PtTrieNode *sibling = node->sibling;
+
+    pt_trie_node_free (node->child);
+    g_clear_pointer (&node->entries, g_array_unref);
+    g_free (node);
+    node = sibling;
+  }
+}
+
+
+static PtTrieNode *
+pt_trie_node_lookup (PtTrieNode *node, char c)
+{
+  for (PtTrieNode *child = node->child; child; child = child->sibling) {
+    if (child->c == c)
+      return child;
+  }
+
+  return NULL;
+}
+
+
+static void
+append_entry (GArray **entries, guint rule, gboolean negated)
+{
+  PtCompatibleMatcherEntry entry = { .rule = rule, .negated = negated };
+
+  if (*entries == NULL)
+    *entries = g_array_new (FALSE, FALSE, sizeof (PtCompatibleMatcherEntry));
+
+  g_array_append_val (*entries, entry);
+}
+
+
+static void
+add_prefix (PtCompatibleMatcher *self, const char *prefix, gsize len, guint rule, gboolean negated)
+{
+  PtTrieNode *node = self->prefixes;
+
+  for (gsize i = 0; i < len; i++) {
+    PtTrieNode *child = pt_trie_node_lookup (node, prefix[i]);
+
+    if (child == NULL) {
+      child = g_new0 (PtTrieNode, 1);
+      child->c = prefix[i];
+      child->sibling = node->child;
+      node->child = child;
+    }
+    node = child;
+  }
+
+  append_entry (&node->entries, rule, negated);
+}
+
+
+static void
+add_exact (PtCompatibleMatcher *self, const char *compatible, guint rule, gboolean negated)
+{
+  GArray *entries = g_hash_table_lookup (self->exact, compatible);
+  gboolean is_new = entries == NULL;
+
+  append_entry (&entries, rule, negated);
+  if (is_new)
+    g_hash_table_insert (self->exact, g_strdup (compatible), entries);
+}
+
+
+static void
+apply_entries (PtCompatibleMatcher *self, GArray *entries)
+{
+  if (entries == NULL)
+    return;
+
+  for (guint i = 0; i < entries->len; i++) {
+    PtCompatibleMatcherEntry *entry = &g_array_index (entries, PtCompatibleMatcherEntry, i);
+    PtCompatibleMatcherRule *rule = &g_array_index (self->rules, PtCompatibleMatcherRule, entry->rule);
+
+    if (entry->negated)
+      rule->negative = TRUE;
+    else
+      rule->positive = TRUE;
+  }
+}
+
+
+PtCompatibleMatcher *
+pt_compatible_matcher_new (void)
+{
+  PtCompatibleMatcher *self = g_new0 (PtCompatibleMatcher, 1);
+
+  self->exact = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                       g_free, (GDestroyNotify) g_array_unref);
+  self->prefixes = g_new0 (PtTrieNode, 1);
+  self->rules = g_array_new (FALSE, TRUE, sizeof (PtCompatibleMatcherRule));
+
+  return self;
+}
+
+
+void
+pt_compatible_matcher_free (PtCompatibleMatcher *self)
+{
+  g_return_if_fail (self != NULL);
+
+  g_hash_table_unref (self->exact);
+  pt_trie_node_free (self->prefixes);
+  g_array_unref (self->rules);
+  g_free (self);
+}
+
+/**
+ * pt_compatible_matcher_add_rule:
+ * @self: The matcher
+ * @patterns: The rule's compatible patterns
+ *
+ * Adds a rule. Its result is available via
+ * [method@CompatibleMatcher.get_result] after the next
+ * [method@CompatibleMatcher.match].
+ *
+ * Returns: The rule's id
+ */
+guint
+pt_compatible_matcher_add_rule (PtCompatibleMatcher *self, const char *const *patterns)
+{
+  PtCompatibleMatcherRule rule = { 0 };
+  guint id;
+
+  g_return_val_if_fail (self != NULL, 0);
+
+  id = self->rules->len;
+  for (int i = 0; patterns && patterns[i]; i++) {
+    const char *pattern = patterns[i];
+    gboolean negated = FALSE;
+    gsize len;
+
+    if (pattern[0] == '!') {
+      negated = TRUE;
+      pattern++;
+    }
+
+    len = strlen (pattern);
+    if (len == 0) {
+      g_warning ("Ignoring empty compatible pattern");
+      continue;
+    }
+
+    if (negated)
+      rule.has_negative = TRUE;
+    else
+      rule.has_positive = TRUE;
+
+    if (pattern[len - 1] == '*')
+      add_prefix (self, pattern, len - 1, id, negated);
+    else
+      add_exact (self, pattern, id, negated);
+  }
+  g_array_append_val (self->rules, rule);
+
+  return id;
+}
+
+/**
+ * pt_compatible_matcher_match:
+ * @self: The matcher
+ * @compatibles: (nullable): The device's compatibles
+ *
+ * Evaluates all rules against the given compatibles.
+ */
+void
+pt_compatible_matcher_match (PtCompatibleMatcher *self, const char *const *compatibles)
+{
+  g_return_if_fail (self != NULL);
+
+  for (guint i = 0; i < self->rules->len; i++) {
+    PtCompatibleMatcherRule *rule = &g_array_index (self->rules, PtCompatibleMatcherRule, i);
+
+    rule->positive = rule->negative = FALSE;
+  }
+
+  for (int i = 0; compatibles && compatibles[i]; i++) {
+    PtTrieNode *node = self->prefixes;
+
+    apply_entries (self, g_hash_table_lookup (self->exact, compatibles[i]));
+
+    /* Every node on the compatible's path is a matching prefix */
+    apply_entries (self, node->entries);
+    for (const char *c = compatibles[i]; *c && node; c++) {
+      node = pt_trie_node_lookup (node, *c);
+      if (node)
+        apply_entries (self, node->entries);
+    }
+  }
+}
+
+
+gboolean
+pt_compatible_matcher_get_result (PtCompatibleMatcher *self, guint rule)
+{
+  PtCompatibleMatcherRule *r;
+
+  g_return_val_if_fail (self != NULL, FALSE);
+  g_return_val_if_fail (rule < self->rules->len, FALSE);
+
+  r = &g_array_index (self->rules, PtCompatibleMatcherRule, rule);
+  if (r->negative)
+    return FALSE;
+
+  if (r->has_positive)
+    return r->positive;
+
+  return r->has_negative;
+}
+
+
+/**
+ * pt_compatible_matcher_match_one:
+ * @patterns: (nullable): Compatible patterns
+ * @compatibles: (nullable): The compatibles to match against
+ *
+ * Convenience function to evaluate a single rule.
+ *
+ * Returns: %TRUE if the patterns match the compatibles
+ */
+gboolean
+pt_compatible_matcher_match_one (const char *const *patterns, const char *const *compatibles)
+{
+  g_autoptr (PtCompatibleMatcher) matcher = pt_compatible_matcher_new ();
+  guint rule;
+
+  rule = pt_compatible_matcher_add_rule (matcher, patterns);
+  pt_compatible_matcher_match (matcher, compatibles);
+
+  return pt_compatible_matcher_get_result (matcher, rule);
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _PtCompatibleMatcher PtCompatibleMatcher;
+
+PtCompatibleMatcher *pt_compatible_matcher_new        (void);
+void                 pt_compatible_matcher_free       (PtCompatibleMatcher *self);
+guint                pt_compatible_matcher_add_rule   (PtCompatibleMatcher *self,
+                                                       const char *const   *patterns);
+void                 pt_compatible_matcher_match      (PtCompatibleMatcher *self,
+                                                       const char *const   *compatibles);
+gboolean             pt_compatible_matcher_get_result (PtCompatibleMatcher *self,
+                                                       guint                rule);
+gboolean             pt_compatible_matcher_match_one  (const char *const   *patterns,
+                                                       const char *const   *compatibles);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (PtCompatibleMatcher, pt_compatible_matcher_free)
+
+G_END_DECLS
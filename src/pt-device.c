@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-device"
+
+#include "phosh-tour-config.h"
+
+#include "pt-device.h"
+#include "pt-trace.h"
+
+#define GMOBILE_USE_UNSTABLE_API
+#include <gmobile.h>
+
+#include <string.h>
+
+/**
+ * pt_device_get_compatibles:
+ *
+ * Gets the device tree compatibles of the device we're running on.
+ * They're only read once and then cached for the process' lifetime.
+ *
+ * Returns:(transfer none)(nullable): The device's compatibles
+ */
+const char *const *
+pt_device_get_compatibles (void)
+{
+  static GStrv compatibles;
+  static gsize initialized;
+
+  if (g_once_init_enter (&initialized)) {
+    g_autoptr (GError) err = NULL;
+    gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+
+    compatibles = gm_device_tree_get_compatibles (NULL, &err);
+    if (compatibles == NULL)
+      g_debug ("No device tree compatibles: %s", err ? err->message : "none");
+    PT_TRACE_MARK (begin, "device-tree", "%u compatibles",
+                   compatibles ? g_strv_length (compatibles) : 0);
+
+    g_once_init_leave (&initialized, 1);
+  }
+
+  return (const char *const *)compatibles;
+}
+
+
+/**
+ * pt_device_load_bundles:
+ *
+ * Registers the resource bundles with hardware specific page assets
+ * that match the device's compatibles. Bundles are looked up in
+ * `PHOSH_TOUR_BUNDLES_DIR` (overridable via the environment variable
+ * of the same name) as `<compatible>.gresource`. The files are mmapped
+ * so only the assets that are actually used are paged in.
+ *
+ * Bundles are only loaded once and stay registered for the process'
+ * lifetime.
+ */
+void
+pt_device_load_bundles (void)
+{
+  static gsize initialized;
+  const char *const *compatibles;
+  const char *dir;
+
+  if (!g_once_init_enter (&initialized))
+    return;
+
+  dir = g_getenv ("PHOSH_TOUR_BUNDLES_DIR") ?: PHOSH_TOUR_BUNDLES_DIR;
+  compatibles = pt_device_get_compatibles ();
+
+  for (int i = 0; compatibles && compatibles[i]; i++) {
+    g_autofree char *filename = g_strdup_printf ("%s.gresource", compatibles[i]);
+    g_autofree char *path = g_build_filename (dir, filename, NULL);
+    g_autoptr (GError) err = NULL;
+    GResource *resource;
+
+    resource = g_resource_load (path, &err);
+    if (resource == NULL) {
+      if (!g_error_matches (err, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+        g_warning ("Failed to load bundle %s: %s", path, err->message);
+      continue;
+    }
+
+    g_debug ("Registering bundle %s", path);
+    g_resources_register (resource);
+    g_resource_unref (resource);
+  }
+
+  g_once_init_leave (&initialized, 1);
+}
+
+
+/**
+ * pt_device_get_mem_available:
+ *
+ * Gets the amount of memory available for starting new applications
+ * without swapping as estimated by the kernel.
+ *
+ * Returns: The available memory in KiB or `-1` if unknown
+ */
+gint64
+pt_device_get_mem_available (void)
+{
+  g_autofree char *meminfo = NULL;
+  g_autoptr (GError) err = NULL;
+  const char *line;
+
+  if (!g_file_get_contents ("/proc/meminfo", &meminfo, NULL, &err)) {
+    g_debug ("Failed to read meminfo: %s", err->message);
+    return -1;
+  }
+
+  line = strstr (meminfo, "MemAvailable:");
+  if (line == NULL)
+    return -1;
+
+  return g_ascii_strtoll (line + strlen ("MemAvailable:"), NULL, 10);
+}
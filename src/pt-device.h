@@ -0,0 +1,17 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+const char *const *pt_device_get_compatibles   (void);
+void               pt_device_load_bundles      (void);
+gint64             pt_device_get_mem_available (void);
+
+G_END_DECLS
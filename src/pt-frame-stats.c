@@ -0,0 +1,295 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-frame-stats"
+
+#include "phosh-tour-config.h"
+
+#include "pt-frame-stats.h"
+#include "pt-util.h"
+
+/* Used when the backend doesn't know the display's refresh rate */
+#define PT_FRAME_STATS_DEFAULT_REFRESH_INTERVAL 16667
+
+typedef struct {
+  int      from;
+  int      to;
+  gboolean swipe;
+  gint64   duration;
+  gint64   refresh_interval;
+  guint    dropped;
+  GArray  *intervals;
+} PtFrameStatsTransition;
+
+typedef struct {
+  char                   *output;
+  GArray                 *transitions;
+
+  /* The transition currently being recorded */
+  PtFrameStatsTransition  current;
+  gboolean                active;
+  GdkFrameClock          *frame_clock;
+  gint64                  start_time;
+  gint64                  last_frame_time;
+} PtFrameStats;
+
+static PtFrameStats stats;
+
+
+static void
+pt_frame_stats_transition_clear (gpointer data)
+{
+  PtFrameStatsTransition *transition = data;
+
+  g_clear_pointer (&transition->intervals, g_array_unref);
+}
+
+
+/**
+ * pt_frame_stats_init:
+ *
+ * Initializes frame statistics. When enabled via the
+ * `PHOSH_TOUR_FRAME_STATS` environment variable (a file name or `-`
+ * for stdout) the intervals between frames are recorded during page
+ * transitions so stutter can be compared across devices and releases.
+ * The result is written as JSON by [func@frame_stats_dump].
+ */
+void
+pt_frame_stats_init (void)
+{
+  const char *env = g_getenv ("PHOSH_TOUR_FRAME_STATS");
+
+  if (env == NULL || env[0] == '\0')
+    return;
+
+  stats.output = g_strdup (env);
+  stats.transitions = g_array_new (FALSE, FALSE, sizeof (PtFrameStatsTransition));
+  g_array_set_clear_func (stats.transitions, pt_frame_stats_transition_clear);
+}
+
+
+gboolean
+pt_frame_stats_is_enabled (void)
+{
+  return !!stats.transitions;
+}
+
+
+static void
+on_after_paint (GdkFrameClock *frame_clock)
+{
+  PtFrameStatsTransition *transition = &stats.current;
+  gint64 frame_time = gdk_frame_clock_get_frame_time (frame_clock);
+  gint64 refresh_interval = 0;
+  gint64 interval;
+
+  /* The first frame has no predecessor within the transition */
+  if (stats.last_frame_time == 0) {
+    stats.last_frame_time = frame_time;
+    return;
+  }
+
+  interval = frame_time - stats.last_frame_time;
+  stats.last_frame_time = frame_time;
+  g_array_append_val (transition->intervals, interval);
+
+  gdk_frame_clock_get_refresh_info (frame_clock, frame_time, &refresh_interval, NULL);
+  if (refresh_interval <= 0)
+    refresh_interval = PT_FRAME_STATS_DEFAULT_REFRESH_INTERVAL;
+  transition->refresh_interval = refresh_interval;
+
+  /* Every refresh cycle without a new frame is a dropped one */
+  if (interval > refresh_interval + refresh_interval / 2)
+    transition->dropped += (interval + refresh_interval / 2) / refresh_interval - 1;
+}
+
+
+/**
+ * pt_frame_stats_begin:
+ * @widget: The widget whose frame clock to record
+ * @from: The page the transition starts from
+ * @to: The target page or `-1` if not yet known (e.g. on swipes)
+ *
+ * Starts recording a page transition. A transition that is still
+ * being recorded is ended first.
+ */
+void
+pt_frame_stats_begin (GtkWidget *widget, int from, int to)
+{
+  GdkFrameClock *frame_clock;
+
+  if (!stats.transitions)
+    return;
+
+  frame_clock = gtk_widget_get_frame_clock (widget);
+  if (frame_clock == NULL)
+    return;
+
+  if (stats.active)
+    pt_frame_stats_end (-1);
+
+  stats.current = (PtFrameStatsTransition) {
+    .from = from,
+    .to = to,
+    .swipe = to < 0,
+    .intervals = g_array_new (FALSE, FALSE, sizeof (gint64)),
+  };
+  stats.active = TRUE;
+  stats.start_time = g_get_monotonic_time ();
+  stats.last_frame_time = 0;
+  stats.frame_clock = g_object_ref (frame_clock);
+  g_signal_connect (frame_clock, "after-paint", G_CALLBACK (on_after_paint), NULL);
+}
+
+
+gboolean
+pt_frame_stats_in_transition (void)
+{
+  return stats.active;
+}
+
+
+/**
+ * pt_frame_stats_end:
+ * @to: The page the transition ended on or `-1` if unknown
+ *
+ * Ends recording the current page transition. Transitions that
+ * didn't paint any frames (e.g. with animations disabled) are
+ * dropped.
+ */
+void
+pt_frame_stats_end (int to)
+{
+  PtFrameStatsTransition *transition = &stats.current;
+
+  if (!stats.active)
+    return;
+
+  stats.active = FALSE;
+  g_signal_handlers_disconnect_by_func (stats.frame_clock, on_after_paint, NULL);
+  g_clear_object (&stats.frame_clock);
+
+  if (to >= 0)
+    transition->to = to;
+
+  if (transition->intervals->len == 0) {
+    pt_frame_stats_transition_clear (transition);
+    return;
+  }
+
+  transition->duration = g_get_monotonic_time () - stats.start_time;
+  g_debug ("Transition %d → %d: %u frames, %u dropped",
+           transition->from, transition->to, transition->intervals->len, transition->dropped);
+
+  g_array_append_val (stats.transitions, *transition);
+  *transition = (PtFrameStatsTransition) { 0 };
+}
+
+
+static int
+compare_interval (gconstpointer a, gconstpointer b)
+{
+  gint64 x = *(const gint64 *)a;
+  gint64 y = *(const gint64 *)b;
+
+  return (x > y) - (x < y);
+}
+
+
+static gint64
+percentile (GArray *sorted, guint p)
+{
+  /* Nearest rank */
+  guint rank = (sorted->len * p + 99) / 100;
+
+  return g_array_index (sorted, gint64, MAX (rank, 1) - 1);
+}
+
+
+static void
+append_summary (GString *json, GArray *intervals, guint dropped)
+{
+  g_autoptr (GArray) sorted = NULL;
+
+  sorted = g_array_copy (intervals);
+  g_array_sort (sorted, compare_interval);
+
+  g_string_append_printf (json,
+                          "\"frames\": %u, \"dropped\": %u, "
+                          "\"p50-usec\": %" G_GINT64_FORMAT ", "
+                          "\"p95-usec\": %" G_GINT64_FORMAT ", "
+                          "\"p99-usec\": %" G_GINT64_FORMAT ", "
+                          "\"max-usec\": %" G_GINT64_FORMAT,
+                          sorted->len,
+                          dropped,
+                          percentile (sorted, 50),
+                          percentile (sorted, 95),
+                          percentile (sorted, 99),
+                          g_array_index (sorted, gint64, sorted->len - 1));
+}
+
+
+/**
+ * pt_frame_stats_dump:
+ *
+ * Writes the recorded frame statistics as JSON. Each transition
+ * gets its own entry, `total` summarizes all of them.
+ */
+void
+pt_frame_stats_dump (void)
+{
+  g_autoptr (GString) json = NULL;
+  g_autoptr (GArray) all = NULL;
+  g_autoptr (GError) err = NULL;
+  guint dropped = 0;
+
+  if (!stats.transitions)
+    return;
+
+  pt_frame_stats_end (-1);
+
+  all = g_array_new (FALSE, FALSE, sizeof (gint64));
+  json = g_string_new ("{\n  \"version\": ");
+  pt_util_append_json_string (json, PHOSH_TOUR_VERSION);
+  g_string_append (json, ",\n  \"gsk-renderer\": ");
+  pt_util_append_json_string (json, g_getenv ("GSK_RENDERER") ?: "");
+  g_string_append (json, ",\n  \"transitions\": [");
+
+  for (guint i = 0; i < stats.transitions->len; i++) {
+    PtFrameStatsTransition *transition;
+
+    transition = &g_array_index (stats.transitions, PtFrameStatsTransition, i);
+    g_string_append_printf (json,
+                            "%s\n    { \"from\": %d, \"to\": %d, \"swipe\": %s, "
+                            "\"duration-usec\": %" G_GINT64_FORMAT ", "
+                            "\"refresh-interval-usec\": %" G_GINT64_FORMAT ", ",
+                            i ? "," : "",
+                            transition->from,
+                            transition->to,
+                            transition->swipe ? "true" : "false",
+                            transition->duration,
+                            transition->refresh_interval);
+    append_summary (json, transition->intervals, transition->dropped);
+    g_string_append (json, " }");
+
+    g_array_append_vals (all, transition->intervals->data, transition->intervals->len);
+    dropped += transition->dropped;
+  }
+  g_string_append (json, "\n  ]");
+
+  if (all->len) {
+    g_string_append (json, ",\n  \"total\": { ");
+    append_summary (json, all, dropped);
+    g_string_append (json, " }");
+  }
+  g_string_append (json, "\n}\n");
+
+  if (!pt_util_write_output (stats.output, json->str, &err))
+    g_warning ("Failed to write frame stats to %s: %s", stats.output, err->message);
+
+  g_clear_pointer (&stats.transitions, g_array_unref);
+  g_clear_pointer (&stats.output, g_free);
+}
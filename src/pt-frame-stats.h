@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+void     pt_frame_stats_init          (void);
+gboolean pt_frame_stats_is_enabled    (void);
+void     pt_frame_stats_begin         (GtkWidget *widget, int from, int to);
+gboolean pt_frame_stats_in_transition (void);
+void     pt_frame_stats_end           (int to);
+void     pt_frame_stats_dump          (void);
+
+G_END_DECLS
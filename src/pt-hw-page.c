@@ -10,6 +10,7 @@
 
 #include "phosh-tour-config.h"
 
+#include "pt-compatible-matcher.h"
 #include "pt-hw-page.h"
 
 #define GMOBILE_USE_UNSTABLE_API
@@ -19,8 +20,12 @@
  * PtHwPage:
  *
  * A tour page for a specific hardware. A page is considered useful for
- * a certain hardware if the device tree compatibles on the page match
- * any of the devices device tree compatibles.
+ * a certain hardware if the device tree compatible patterns on the page
+ * match the devices device tree compatibles. See
+ * [struct@CompatibleMatcher] for the pattern syntax.
+ *
+ * Pages built from the page manifest are matched all at once before
+ * they're constructed.
  */
 
 enum {
@@ -73,6 +78,7 @@ pt_hw_page_set_property (GObject      *object,
 
   switch (property_id) {
   case PROP_COMPATIBLES:
+    g_clear_pointer (&self->compatibles, g_strfreev);
     self->compatibles = g_value_dup_boxed (value);
     break;
   default:
@@ -181,13 +187,5 @@ pt_hw_page_is_compatible (PtHwPage *self, const char *const *compatibles)
   g_return_val_if_fail (PT_IS_HW_PAGE (self), FALSE);
   g_return_val_if_fail (!gm_strv_is_null_or_empty (self->compatibles), FALSE);
 
-  if (gm_strv_is_null_or_empty (compatibles))
-    return FALSE;
-
-  for (int i = 0; compatibles[i]; i++) {
-    if (g_strv_contains ((const char *const *)self->compatibles, compatibles[i]))
-      return TRUE;
-  }
-
-  return FALSE;
+  return pt_compatible_matcher_match_one ((const char *const *)self->compatibles, compatibles);
 }
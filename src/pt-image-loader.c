@@ -0,0 +1,583 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-image-loader"
+
+#include "phosh-tour-config.h"
+
+#include "pt-image-loader.h"
+#include "pt-scaled-texture.h"
+#include "pt-sprite-paintable.h"
+#include "pt-trace.h"
+
+#include <adwaita.h>
+
+#define PT_IMAGE_LOADER_MAX_RASTER_SCALE 3
+#define PT_IMAGE_LOADER_MAX_SPRITE_SCALE 2
+#define PT_IMAGE_LOADER_SPRITE_GROUP "Animation"
+#define PT_IMAGE_LOADER_DEFAULT_CACHE_SIZE (8 * 1024 * 1024)
+#define PT_IMAGE_LOADER_KEY "pt-image-loader-key"
+#define PT_IMAGE_LOADER_SPRITE "pt-image-loader-sprite"
+
+/**
+ * PtImageLoader:
+ *
+ * Loads page images off the main thread. Images handed back via
+ * [func@image_loader_release] once they're no longer shown are kept
+ * in a size bounded LRU cache keyed by URI, scale factor and theme so
+ * e.g. moving between monitors with different scale factors or
+ * reloading an image released due to memory pressure doesn't decode
+ * again. Images that are shown are never in the cache so releasing
+ * them actually frees memory once the cache is full.
+ *
+ * The pixel size of an image is determined by its URI and scale as
+ * the rasters are rendered at build time so it's not part of the key.
+ *
+ * Images in resources that come with a pre-rendered sprite sheet are
+ * returned as #PtSpritePaintable so pages can play the animation. As
+ * these track the widget they play on only their textures are cached
+ * and every load gets a new paintable.
+ */
+
+typedef struct {
+  char *uri;
+  int   scale;
+  char *key;
+} PtImageLoadData;
+
+typedef struct {
+  GdkTexture *sheet;
+  guint       frames;
+  int         top;
+  int         height;
+  guint       duration;
+} PtSpriteData;
+
+typedef struct {
+  char         *key;
+  /* The still image, for sprites their base */
+  GdkPaintable *paintable;
+  PtSpriteData *sprite;
+  gsize         size;
+} PtImageCacheEntry;
+
+typedef struct {
+  GMutex              mutex;
+  GHashTable         *entries;
+  /* Least recently used entries last */
+  GQueue              lru;
+  gsize               max_size;
+  PtImageLoaderStats  stats;
+} PtImageCache;
+
+static PtImageCache cache = {
+  .max_size = PT_IMAGE_LOADER_DEFAULT_CACHE_SIZE,
+};
+
+
+static void
+pt_image_load_data_free (PtImageLoadData *data)
+{
+  g_free (data->uri);
+  g_free (data->key);
+  g_free (data);
+}
+
+
+static void
+pt_sprite_data_clear (PtSpriteData *sprite)
+{
+  g_object_unref (sprite->sheet);
+}
+
+
+static PtSpriteData *
+pt_sprite_data_ref (PtSpriteData *sprite)
+{
+  return g_atomic_rc_box_acquire (sprite);
+}
+
+
+static void
+pt_sprite_data_unref (PtSpriteData *sprite)
+{
+  g_atomic_rc_box_release_full (sprite, (GDestroyNotify) pt_sprite_data_clear);
+}
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (PtSpriteData, pt_sprite_data_unref)
+
+
+static void
+pt_image_cache_entry_free (PtImageCacheEntry *entry)
+{
+  g_free (entry->key);
+  g_object_unref (entry->paintable);
+  g_clear_pointer (&entry->sprite, pt_sprite_data_unref);
+  g_free (entry);
+}
+
+
+/* Wraps a decoded image into the paintable handed out to pages */
+static GdkPaintable *
+new_image (const char *key, GdkPaintable *still, PtSpriteData *sprite)
+{
+  GdkPaintable *paintable;
+
+  if (sprite) {
+    paintable = GDK_PAINTABLE (pt_sprite_paintable_new (still,
+                                                        sprite->sheet,
+                                                        sprite->frames,
+                                                        sprite->top,
+                                                        sprite->height,
+                                                        sprite->duration));
+    g_object_set_data_full (G_OBJECT (paintable), PT_IMAGE_LOADER_SPRITE,
+                            pt_sprite_data_ref (sprite),
+                            (GDestroyNotify) pt_sprite_data_unref);
+  } else {
+    paintable = g_object_ref (still);
+  }
+
+  g_object_set_data_full (G_OBJECT (paintable), PT_IMAGE_LOADER_KEY, g_strdup (key), g_free);
+
+  return paintable;
+}
+
+
+/* Must be called with the cache locked */
+static void
+cache_trim (gsize max_size)
+{
+  while (cache.stats.size > max_size) {
+    PtImageCacheEntry *entry = g_queue_pop_tail (&cache.lru);
+
+    cache.stats.size -= entry->size;
+    cache.stats.entries--;
+    cache.stats.evictions++;
+    g_hash_table_remove (cache.entries, entry->key);
+  }
+}
+
+
+/* Hits are taken out of the cache until they're released again */
+static GdkPaintable *
+cache_take (const char *key)
+{
+  g_autoptr (GMutexLocker) locker = g_mutex_locker_new (&cache.mutex);
+  PtImageCacheEntry *entry = NULL;
+  GdkPaintable *paintable;
+
+  if (cache.entries)
+    entry = g_hash_table_lookup (cache.entries, key);
+
+  if (entry == NULL) {
+    cache.stats.misses++;
+    return NULL;
+  }
+
+  cache.stats.hits++;
+  cache.stats.size -= entry->size;
+  cache.stats.entries--;
+  g_queue_remove (&cache.lru, entry);
+
+  paintable = new_image (key, entry->paintable, entry->sprite);
+  g_hash_table_remove (cache.entries, key);
+
+  return paintable;
+}
+
+
+static void
+cache_insert (const char *key, GdkPaintable *paintable, PtSpriteData *sprite)
+{
+  g_autoptr (GMutexLocker) locker = g_mutex_locker_new (&cache.mutex);
+  PtImageCacheEntry *entry;
+  gsize size = pt_image_loader_get_paintable_size (paintable);
+
+  if (sprite)
+    size += pt_image_loader_get_paintable_size (GDK_PAINTABLE (sprite->sheet));
+
+  if (size > cache.max_size)
+    return;
+
+  if (cache.entries == NULL) {
+    cache.entries = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                           (GDestroyNotify) pt_image_cache_entry_free);
+  }
+
+  /* Another copy of the same image might have been released already */
+  if (g_hash_table_contains (cache.entries, key))
+    return;
+
+  cache_trim (cache.max_size - size);
+
+  entry = g_new0 (PtImageCacheEntry, 1);
+  entry->key = g_strdup (key);
+  entry->paintable = g_object_ref (paintable);
+  entry->sprite = sprite ? pt_sprite_data_ref (sprite) : NULL;
+  entry->size = size;
+  g_hash_table_insert (cache.entries, entry->key, entry);
+  g_queue_push_head (&cache.lru, entry);
+
+  cache.stats.size += size;
+  cache.stats.entries++;
+}
+
+
+static char *
+get_raster_path (const char *path, const char *subdir, int scale)
+{
+  g_autofree char *dirname = g_path_get_dirname (path);
+  g_autofree char *basename = g_path_get_basename (path);
+  char *ext = strrchr (basename, '.');
+
+  if (ext)
+    *ext = '\0';
+
+  return g_strdup_printf ("%s/%s/%s@%dx.png", dirname, subdir, basename, scale);
+}
+
+
+static char *
+get_sprite_metadata_path (const char *path)
+{
+  g_autofree char *dirname = g_path_get_dirname (path);
+  g_autofree char *basename = g_path_get_basename (path);
+  char *ext = strrchr (basename, '.');
+
+  if (ext)
+    *ext = '\0';
+
+  return g_strdup_printf ("%s/sprites/%s.sprite", dirname, basename);
+}
+
+
+static PtScaledTexture *
+load_scaled_texture (const char *path,
+                     const char *subdir,
+                     int         scale,
+                     int         max_scale,
+                     GError    **error)
+{
+  int candidates[PT_IMAGE_LOADER_MAX_RASTER_SCALE];
+  int n = 0;
+
+  g_assert (max_scale <= PT_IMAGE_LOADER_MAX_RASTER_SCALE);
+
+  /* Prefer exact and larger scales as downscaling looks better than upscaling */
+  for (int s = MIN (scale, max_scale); s <= max_scale; s++)
+    candidates[n++] = s;
+  for (int s = MIN (scale, max_scale) - 1; s > 0; s--)
+    candidates[n++] = s;
+
+  for (int i = 0; i < n; i++) {
+    g_autofree char *raster_path = get_raster_path (path, subdir, candidates[i]);
+    g_autoptr (GBytes) bytes = NULL;
+    g_autoptr (GdkTexture) texture = NULL;
+
+    bytes = g_resources_lookup_data (raster_path, G_RESOURCE_LOOKUP_FLAGS_NONE, NULL);
+    if (bytes == NULL)
+      continue;
+
+    g_debug ("Using %s for scale %d", raster_path, scale);
+    texture = gdk_texture_new_from_bytes (bytes, error);
+    if (texture == NULL)
+      return NULL;
+
+    return pt_scaled_texture_new (texture, candidates[i]);
+  }
+
+  return NULL;
+}
+
+
+/* Returns %NULL without setting @error if there's no animation */
+static PtSpriteData *
+load_sprite (const char *path, int scale, GError **error)
+{
+  g_autofree char *metadata_path = get_sprite_metadata_path (path);
+  g_autoptr (GBytes) bytes = NULL;
+  g_autoptr (GKeyFile) keyfile = g_key_file_new ();
+  g_autoptr (PtScaledTexture) sheet = NULL;
+  GError *local_error = NULL;
+  PtSpriteData *sprite;
+  int frames, top, height, duration;
+
+  bytes = g_resources_lookup_data (metadata_path, G_RESOURCE_LOOKUP_FLAGS_NONE, NULL);
+  if (bytes == NULL)
+    return NULL;
+
+  if (!g_key_file_load_from_bytes (keyfile, bytes, G_KEY_FILE_NONE, error))
+    return NULL;
+
+  frames = g_key_file_get_integer (keyfile, PT_IMAGE_LOADER_SPRITE_GROUP, "Frames", NULL);
+  top = g_key_file_get_integer (keyfile, PT_IMAGE_LOADER_SPRITE_GROUP, "Top", NULL);
+  height = g_key_file_get_integer (keyfile, PT_IMAGE_LOADER_SPRITE_GROUP, "Height", NULL);
+  duration = g_key_file_get_integer (keyfile, PT_IMAGE_LOADER_SPRITE_GROUP, "Duration", NULL);
+  if (frames <= 0 || height <= 0 || duration <= 0) {
+    g_set_error (error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                 "Invalid sprite metadata in %s", metadata_path);
+    return NULL;
+  }
+
+  sheet = load_scaled_texture (path, "sprites", scale, PT_IMAGE_LOADER_MAX_SPRITE_SCALE,
+                               &local_error);
+  if (sheet == NULL) {
+    if (local_error) {
+      g_propagate_error (error, local_error);
+      return NULL;
+    }
+    g_warning ("No sprite sheet for %s", path);
+    return NULL;
+  }
+
+  sprite = g_atomic_rc_box_new0 (PtSpriteData);
+  sprite->sheet = g_object_ref (pt_scaled_texture_get_texture (sheet));
+  sprite->frames = frames;
+  sprite->top = top;
+  sprite->height = height;
+  sprite->duration = duration;
+
+  return sprite;
+}
+
+
+static GdkPaintable *
+load_raster_image (const char *path, int scale, PtSpriteData **sprite, GError **error)
+{
+  g_autoptr (PtScaledTexture) texture = NULL;
+  GError *local_error = NULL;
+
+  texture = load_scaled_texture (path, "raster", scale, PT_IMAGE_LOADER_MAX_RASTER_SCALE, error);
+  if (texture == NULL)
+    return NULL;
+
+  *sprite = load_sprite (path, scale, &local_error);
+  if (local_error) {
+    g_propagate_error (error, local_error);
+    return NULL;
+  }
+
+  return GDK_PAINTABLE (g_steal_pointer (&texture));
+}
+
+
+static void
+load_image (GTask *task, PtImageLoadData *data, GCancellable *cancellable)
+{
+  g_autoptr (GdkPaintable) paintable = NULL;
+  g_autoptr (PtSpriteData) sprite = NULL;
+  g_autoptr (GdkTexture) texture = NULL;
+  g_autoptr (GBytes) bytes = NULL;
+  g_autoptr (GFile) file = NULL;
+  GError *error = NULL;
+
+  if (g_str_has_prefix (data->uri, "resource://")) {
+    paintable = load_raster_image (&data->uri[strlen ("resource://")], data->scale, &sprite,
+                                   &error);
+    if (error) {
+      g_task_return_error (task, error);
+      return;
+    }
+    if (paintable) {
+      g_task_return_pointer (task, new_image (data->key, paintable, sprite), g_object_unref);
+      return;
+    }
+  }
+
+  if (g_task_return_error_if_cancelled (task))
+    return;
+
+  file = g_file_new_for_uri (data->uri);
+  bytes = g_file_load_bytes (file, cancellable, NULL, &error);
+  if (bytes == NULL) {
+    g_task_return_error (task, error);
+    return;
+  }
+
+  texture = gdk_texture_new_from_bytes (bytes, &error);
+  if (texture == NULL) {
+    g_task_return_error (task, error);
+    return;
+  }
+
+  g_task_return_pointer (task, new_image (data->key, GDK_PAINTABLE (texture), NULL),
+                         g_object_unref);
+}
+
+
+static void
+load_image_thread (GTask        *task,
+                   gpointer      source_object,
+                   gpointer      task_data,
+                   GCancellable *cancellable)
+{
+  PtImageLoadData *data = task_data;
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+
+  load_image (task, data, cancellable);
+  PT_TRACE_MARK (begin, "image-decode", "%s", data->key);
+}
+
+
+/**
+ * pt_image_loader_load_async:
+ * @uri: The image's URI
+ * @scale: The scale factor the image will be displayed at
+ * @cancellable: (nullable): A cancellable
+ * @callback: The callback to invoke when loading finished
+ * @user_data: The callback's user data
+ *
+ * Loads a page image in a worker thread so decoding never blocks the
+ * main loop. For images in resources pre-rasterized variants matching
+ * @scale are preferred over the SVG. Cached images are returned without
+ * decoding again.
+ */
+void
+pt_image_loader_load_async (const char          *uri,
+                            int                  scale,
+                            GCancellable        *cancellable,
+                            GAsyncReadyCallback  callback,
+                            gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+  g_autoptr (GdkPaintable) paintable = NULL;
+  PtImageLoadData *data;
+  gboolean dark;
+
+  g_return_if_fail (uri != NULL);
+  g_return_if_fail (scale > 0);
+
+  dark = adw_style_manager_get_dark (adw_style_manager_get_default ());
+
+  data = g_new0 (PtImageLoadData, 1);
+  data->uri = g_strdup (uri);
+  data->scale = scale;
+  data->key = g_strdup_printf ("%s@%dx:%s", uri, scale, dark ? "dark" : "light");
+
+  task = g_task_new (NULL, cancellable, callback, user_data);
+  g_task_set_source_tag (task, pt_image_loader_load_async);
+  g_task_set_task_data (task, data, (GDestroyNotify) pt_image_load_data_free);
+
+  paintable = cache_take (data->key);
+  if (paintable) {
+    g_task_return_pointer (task, g_steal_pointer (&paintable), g_object_unref);
+    return;
+  }
+
+  g_task_run_in_thread (task, load_image_thread);
+}
+
+
+/**
+ * pt_image_loader_load_finish:
+ * @res: The async result
+ * @error: The return location for an error
+ *
+ * Finishes an image load started with [func@image_loader_load_async].
+ *
+ * Returns:(transfer full): The loaded image
+ */
+GdkPaintable *
+pt_image_loader_load_finish (GAsyncResult *res, GError **error)
+{
+  g_return_val_if_fail (g_task_is_valid (res, NULL), NULL);
+  g_return_val_if_fail (g_task_get_source_tag (G_TASK (res)) == pt_image_loader_load_async, NULL);
+
+  return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+
+/**
+ * pt_image_loader_release:
+ * @paintable: An image returned by the loader
+ *
+ * Hands an image that's no longer shown back to the loader so it can
+ * be cached. Does nothing for paintables that didn't come from the
+ * loader.
+ */
+void
+pt_image_loader_release (GdkPaintable *paintable)
+{
+  const char *key;
+  PtSpriteData *sprite;
+
+  g_return_if_fail (GDK_IS_PAINTABLE (paintable));
+
+  key = g_object_get_data (G_OBJECT (paintable), PT_IMAGE_LOADER_KEY);
+  if (key == NULL)
+    return;
+
+  sprite = g_object_get_data (G_OBJECT (paintable), PT_IMAGE_LOADER_SPRITE);
+  if (sprite)
+    paintable = pt_sprite_paintable_get_base (PT_SPRITE_PAINTABLE (paintable));
+
+  cache_insert (key, paintable, sprite);
+}
+
+
+/**
+ * pt_image_loader_set_cache_size:
+ * @max_size: The maximum size in bytes
+ *
+ * Sets the maximum memory used by cached images. Least recently used
+ * images are dropped to stay within the limit. 0 disables caching.
+ */
+void
+pt_image_loader_set_cache_size (gsize max_size)
+{
+  g_autoptr (GMutexLocker) locker = g_mutex_locker_new (&cache.mutex);
+
+  cache.max_size = max_size;
+  cache_trim (max_size);
+}
+
+/**
+ * pt_image_loader_get_cache_stats:
+ * @stats: (out): The statistics
+ *
+ * Gets statistics about the image cache.
+ */
+void
+pt_image_loader_get_cache_stats (PtImageLoaderStats *stats)
+{
+  g_autoptr (GMutexLocker) locker = g_mutex_locker_new (&cache.mutex);
+
+  g_return_if_fail (stats != NULL);
+
+  *stats = cache.stats;
+}
+
+/**
+ * pt_image_loader_get_paintable_size:
+ * @paintable: A paintable returned by the loader
+ *
+ * Gets the memory used by a decoded image.
+ *
+ * Returns: The size of the image's pixel data in bytes, 0 if
+ *   @paintable isn't backed by a texture
+ */
+gsize
+pt_image_loader_get_paintable_size (GdkPaintable *paintable)
+{
+  GdkTexture *texture;
+
+  if (PT_IS_SPRITE_PAINTABLE (paintable)) {
+    PtSpritePaintable *sprite = PT_SPRITE_PAINTABLE (paintable);
+
+    texture = pt_sprite_paintable_get_sheet (sprite);
+    return pt_image_loader_get_paintable_size (pt_sprite_paintable_get_base (sprite)) +
+      pt_image_loader_get_paintable_size (GDK_PAINTABLE (texture));
+  }
+
+  if (PT_IS_SCALED_TEXTURE (paintable))
+    texture = pt_scaled_texture_get_texture (PT_SCALED_TEXTURE (paintable));
+  else if (GDK_IS_TEXTURE (paintable))
+    texture = GDK_TEXTURE (paintable);
+  else
+    return 0;
+
+  /* Textures are uploaded as 32bit RGBA */
+  return (gsize) gdk_texture_get_width (texture) * gdk_texture_get_height (texture) * 4;
+}
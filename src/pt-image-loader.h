@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+typedef struct {
+  guint hits;
+  guint misses;
+  guint evictions;
+  guint entries;
+  gsize size;
+} PtImageLoaderStats;
+
+void          pt_image_loader_load_async         (const char          *uri,
+                                                  int                  scale,
+                                                  GCancellable        *cancellable,
+                                                  GAsyncReadyCallback  callback,
+                                                  gpointer             user_data);
+GdkPaintable *pt_image_loader_load_finish        (GAsyncResult        *res,
+                                                  GError             **error);
+void          pt_image_loader_release            (GdkPaintable        *paintable);
+void          pt_image_loader_set_cache_size     (gsize                max_size);
+void          pt_image_loader_get_cache_stats    (PtImageLoaderStats  *stats);
+gsize         pt_image_loader_get_paintable_size (GdkPaintable        *paintable);
+
+G_END_DECLS
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-low-power"
+
+#include "phosh-tour-config.h"
+
+#include "pt-low-power.h"
+
+/**
+ * PtLowPower:
+ *
+ * Tracks whether the tour should save power and avoid motion. This is
+ * the case if it's forced (e.g. via the command line), if the power
+ * profile daemon reports the `power-saver` profile or if animations
+ * are disabled in the desktop settings.
+ *
+ * The power profile is read from the daemon's D-Bus interface on the
+ * system bus. Pointing `DBUS_SYSTEM_BUS_ADDRESS` to a different bus
+ * allows a stand-in to emulate it.
+ */
+
+#define POWER_PROFILES_BUS_NAME    "net.hadess.PowerProfiles"
+#define POWER_PROFILES_OBJECT_PATH "/net/hadess/PowerProfiles"
+#define POWER_PROFILES_INTERFACE   "net.hadess.PowerProfiles"
+
+enum {
+  PROP_0,
+  PROP_FORCED,
+  PROP_SETTINGS,
+  PROP_ACTIVE,
+  PROP_LAST_PROP
+};
+static GParamSpec *props[PROP_LAST_PROP];
+
+struct _PtLowPower {
+  GObject       parent;
+
+  gboolean      forced;
+  gboolean      power_saver;
+  gboolean      reduce_motion;
+  gboolean      active;
+
+  GtkSettings  *settings;
+  GDBusProxy   *proxy;
+  GCancellable *cancellable;
+};
+
+G_DEFINE_TYPE (PtLowPower, pt_low_power, G_TYPE_OBJECT)
+
+
+static void
+update_active (PtLowPower *self)
+{
+  gboolean active = self->forced || self->power_saver || self->reduce_motion;
+
+  if (self->active == active)
+    return;
+
+  g_debug ("Low power mode %s (forced: %d, power saver: %d, reduce motion: %d)",
+           active ? "enabled" : "disabled",
+           self->forced, self->power_saver, self->reduce_motion);
+  self->active = active;
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_ACTIVE]);
+}
+
+
+static void
+on_animations_changed (PtLowPower *self)
+{
+  gboolean enable_animations;
+
+  g_object_get (self->settings, "gtk-enable-animations", &enable_animations, NULL);
+  self->reduce_motion = !enable_animations;
+  update_active (self);
+}
+
+
+static void
+on_properties_changed (PtLowPower *self)
+{
+  g_autoptr (GVariant) profile = NULL;
+
+  profile = g_dbus_proxy_get_cached_property (self->proxy, "ActiveProfile");
+  self->power_saver = profile &&
+                      g_variant_is_of_type (profile, G_VARIANT_TYPE_STRING) &&
+                      g_str_equal (g_variant_get_string (profile, NULL), "power-saver");
+  update_active (self);
+}
+
+
+static void
+on_proxy_ready (GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  PtLowPower *self;
+  g_autoptr (GError) err = NULL;
+  GDBusProxy *proxy;
+
+  proxy = g_dbus_proxy_new_for_bus_finish (res, &err);
+  if (proxy == NULL) {
+    if (!g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+      g_debug ("Failed to reach power profiles daemon: %s", err->message);
+    return;
+  }
+
+  self = PT_LOW_POWER (user_data);
+  self->proxy = proxy;
+  g_signal_connect_object (self->proxy,
+                           "g-properties-changed",
+                           G_CALLBACK (on_properties_changed),
+                           self,
+                           G_CONNECT_SWAPPED);
+  on_properties_changed (self);
+}
+
+
+static void
+pt_low_power_set_property (GObject      *object,
+                           guint         property_id,
+                           const GValue *value,
+                           GParamSpec   *pspec)
+{
+  PtLowPower *self = PT_LOW_POWER (object);
+
+  switch (property_id) {
+  case PROP_FORCED:
+    self->forced = g_value_get_boolean (value);
+    break;
+  case PROP_SETTINGS:
+    self->settings = g_value_dup_object (value);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_low_power_get_property (GObject    *object,
+                           guint       property_id,
+                           GValue     *value,
+                           GParamSpec *pspec)
+{
+  PtLowPower *self = PT_LOW_POWER (object);
+
+  switch (property_id) {
+  case PROP_FORCED:
+    g_value_set_boolean (value, self->forced);
+    break;
+  case PROP_SETTINGS:
+    g_value_set_object (value, self->settings);
+    break;
+  case PROP_ACTIVE:
+    g_value_set_boolean (value, self->active);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_low_power_constructed (GObject *object)
+{
+  PtLowPower *self = PT_LOW_POWER (object);
+
+  G_OBJECT_CLASS (pt_low_power_parent_class)->constructed (object);
+
+  if (self->settings) {
+    g_signal_connect_object (self->settings,
+                             "notify::gtk-enable-animations",
+                             G_CALLBACK (on_animations_changed),
+                             self,
+                             G_CONNECT_SWAPPED);
+    on_animations_changed (self);
+  }
+  update_active (self);
+
+  /* No need to track the profile when forced anyway */
+  if (self->forced)
+    return;
+
+  self->cancellable = g_cancellable_new ();
+  g_dbus_proxy_new_for_bus (G_BUS_TYPE_SYSTEM,
+                            G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START,
+                            NULL,
+                            POWER_PROFILES_BUS_NAME,
+                            POWER_PROFILES_OBJECT_PATH,
+                            POWER_PROFILES_INTERFACE,
+                            self->cancellable,
+                            on_proxy_ready,
+                            self);
+}
+
+
+static void
+pt_low_power_dispose (GObject *object)
+{
+  PtLowPower *self = PT_LOW_POWER (object);
+
+  g_cancellable_cancel (self->cancellable);
+  g_clear_object (&self->cancellable);
+  g_clear_object (&self->proxy);
+  g_clear_object (&self->settings);
+
+  G_OBJECT_CLASS (pt_low_power_parent_class)->dispose (object);
+}
+
+
+static void
+pt_low_power_class_init (PtLowPowerClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->constructed = pt_low_power_constructed;
+  object_class->dispose = pt_low_power_dispose;
+  object_class->set_property = pt_low_power_set_property;
+  object_class->get_property = pt_low_power_get_property;
+
+  /**
+   * PtLowPower:forced:
+   *
+   * Whether low power mode is always active.
+   */
+  props[PROP_FORCED] =
+    g_param_spec_boolean ("forced", "", "",
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+  /**
+   * PtLowPower:settings:
+   *
+   * The settings to track the desktop's animation setting with.
+   */
+  props[PROP_SETTINGS] =
+    g_param_spec_object ("settings", "", "",
+                         GTK_TYPE_SETTINGS,
+                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+  /**
+   * PtLowPower:active:
+   *
+   * Whether the tour should save power and avoid motion.
+   */
+  props[PROP_ACTIVE] =
+    g_param_spec_boolean ("active", "", "",
+                          FALSE,
+                          G_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
+}
+
+
+static void
+pt_low_power_init (PtLowPower *self)
+{
+}
+
+/**
+ * pt_low_power_new:
+ * @forced: Whether low power mode is always active
+ * @settings:(nullable): The settings to track the desktop's animation setting with
+ *
+ * Returns: A new low power mode tracker
+ */
+PtLowPower *
+pt_low_power_new (gboolean forced, GtkSettings *settings)
+{
+  return g_object_new (PT_TYPE_LOW_POWER, "forced", forced, "settings", settings, NULL);
+}
+
+
+gboolean
+pt_low_power_get_active (PtLowPower *self)
+{
+  g_return_val_if_fail (PT_IS_LOW_POWER (self), FALSE);
+
+  return self->active;
+}
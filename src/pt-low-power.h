@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define PT_TYPE_LOW_POWER (pt_low_power_get_type ())
+
+G_DECLARE_FINAL_TYPE (PtLowPower, pt_low_power, PT, LOW_POWER, GObject)
+
+PtLowPower *pt_low_power_new        (gboolean forced, GtkSettings *settings);
+gboolean    pt_low_power_get_active (PtLowPower *self);
+
+G_END_DECLS
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-memory"
+
+#include "phosh-tour-config.h"
+
+#include "pt-image-loader.h"
+#include "pt-memory.h"
+#include "pt-page.h"
+#include "pt-util.h"
+
+#include <gtk/gtk.h>
+
+typedef struct {
+  guint widgets;
+  guint objects;
+} PtMemoryCounts;
+
+typedef struct {
+  char      *output;
+  gint64     start_time;
+  /* Samples already serialized as JSON objects */
+  GPtrArray *samples;
+} PtMemory;
+
+static PtMemory memory;
+
+/**
+ * pt_memory_init:
+ *
+ * Initializes memory accounting. When enabled via the
+ * `PHOSH_TOUR_MEMORY` environment variable (a file name or `-` for
+ * stdout) [func@memory_sample] records the process' RSS and PSS and
+ * the decoded texture bytes, widgets and objects of each page so the
+ * tour's memory cost can be budgeted per device. The result is
+ * written as JSON by [func@memory_dump].
+ */
+void
+pt_memory_init (void)
+{
+  const char *env = g_getenv ("PHOSH_TOUR_MEMORY");
+
+  memory.start_time = g_get_monotonic_time ();
+
+  if (env == NULL || env[0] == '\0')
+    return;
+
+  memory.output = g_strdup (env);
+  memory.samples = g_ptr_array_new_with_free_func (g_free);
+}
+
+
+gboolean
+pt_memory_is_enabled (void)
+{
+  return !!memory.samples;
+}
+
+
+static gint64
+parse_kib (const char *contents, const char *key)
+{
+  const char *line;
+
+  if (contents == NULL)
+    return -1;
+
+  /* Keys start a line, the first line of smaps_rollup is a header */
+  line = strstr (contents, key);
+  while (line && line != contents && line[-1] != '\n')
+    line = strstr (line + 1, key);
+  if (line == NULL)
+    return -1;
+
+  return g_ascii_strtoll (line + strlen (key), NULL, 10);
+}
+
+
+static void
+count_widget (GtkWidget *widget, PtMemoryCounts *counts)
+{
+  g_autoptr (GListModel) controllers = NULL;
+
+  counts->widgets++;
+  counts->objects++;
+
+  if (gtk_widget_get_layout_manager (widget))
+    counts->objects++;
+
+  controllers = gtk_widget_observe_controllers (widget);
+  counts->objects += g_list_model_get_n_items (controllers);
+
+  if (GTK_IS_PICTURE (widget) && gtk_picture_get_paintable (GTK_PICTURE (widget)))
+    counts->objects++;
+
+  for (GtkWidget *child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    count_widget (child, counts);
+  }
+}
+
+
+static char *
+build_sample (GPtrArray *pages, const char *event)
+{
+  g_autoptr (GString) json = g_string_new ("{ \"event\": ");
+  g_autofree char *rollup = NULL;
+  PtImageLoaderStats stats;
+  gint64 rss, pss;
+  gsize texture_bytes = 0;
+
+  g_file_get_contents ("/proc/self/smaps_rollup", &rollup, NULL, NULL);
+  rss = parse_kib (rollup, "Rss:");
+  pss = parse_kib (rollup, "Pss:");
+  /* smaps_rollup needs Linux 4.14, fall back to plain RSS */
+  if (rss < 0) {
+    g_autofree char *status = NULL;
+
+    g_file_get_contents ("/proc/self/status", &status, NULL, NULL);
+    rss = parse_kib (status, "VmRSS:");
+  }
+
+  pt_image_loader_get_cache_stats (&stats);
+
+  pt_util_append_json_string (json, event);
+  g_string_append_printf (json,
+                          ", \"time-usec\": %" G_GINT64_FORMAT ", "
+                          "\"rss-kib\": %" G_GINT64_FORMAT ", "
+                          "\"pss-kib\": %" G_GINT64_FORMAT ", "
+                          "\"image-cache-bytes\": %" G_GSIZE_FORMAT ",\n      \"pages\": [",
+                          g_get_monotonic_time () - memory.start_time,
+                          rss,
+                          pss,
+                          stats.size);
+
+  for (guint i = 0; pages && i < pages->len; i++) {
+    PtPage *page = g_ptr_array_index (pages, i);
+    PtMemoryCounts counts = { 0 };
+    gsize size = pt_page_get_image_size (page);
+
+    count_widget (GTK_WIDGET (page), &counts);
+    texture_bytes += size;
+
+    g_string_append_printf (json, "%s\n        { \"id\": ", i ? "," : "");
+    pt_util_append_json_string (json, pt_page_get_page_id (page) ?: "");
+    g_string_append_printf (json,
+                            ", \"materialized\": %s, "
+                            "\"texture-bytes\": %" G_GSIZE_FORMAT ", "
+                            "\"widgets\": %u, \"objects\": %u }",
+                            pt_page_is_materialized (page) ? "true" : "false",
+                            size,
+                            counts.widgets,
+                            counts.objects);
+  }
+
+  g_string_append_printf (json,
+                          "\n      ],\n      \"texture-bytes\": %" G_GSIZE_FORMAT " }",
+                          texture_bytes);
+
+  return g_string_free (g_steal_pointer (&json), FALSE);
+}
+
+
+static char *
+build_json (GPtrArray *samples)
+{
+  g_autoptr (GString) json = g_string_new ("{\n  \"version\": ");
+
+  pt_util_append_json_string (json, PHOSH_TOUR_VERSION);
+  g_string_append (json, ",\n  \"samples\": [");
+  for (guint i = 0; i < samples->len; i++)
+    g_string_append_printf (json, "%s\n    %s", i ? "," : "", (char *) g_ptr_array_index (samples, i));
+  g_string_append (json, "\n  ]\n}\n");
+
+  return g_string_free (g_steal_pointer (&json), FALSE);
+}
+
+/**
+ * pt_memory_sample:
+ * @pages: (nullable): The tour's pages
+ * @format: The printf-style format of the sample's event name
+ * @...: The format's arguments
+ *
+ * Records the current memory usage if accounting is enabled.
+ */
+void
+pt_memory_sample (GPtrArray *pages, const char *format, ...)
+{
+  g_autofree char *event = NULL;
+  va_list args;
+
+  if (!memory.samples)
+    return;
+
+  va_start (args, format);
+  event = g_strdup_vprintf (format, args);
+  va_end (args);
+
+  g_ptr_array_add (memory.samples, build_sample (pages, event));
+}
+
+/**
+ * pt_memory_report:
+ * @pages: (nullable): The tour's pages
+ *
+ * Records the current memory usage and writes all samples so far. If
+ * accounting isn't enabled only the current usage is written to
+ * stdout.
+ */
+void
+pt_memory_report (GPtrArray *pages)
+{
+  g_autoptr (GPtrArray) samples = NULL;
+  g_autofree char *json = NULL;
+  g_autoptr (GError) err = NULL;
+  const char *output = memory.output ?: "-";
+
+  if (memory.samples) {
+    pt_memory_sample (pages, "report");
+    samples = g_ptr_array_ref (memory.samples);
+  } else {
+    samples = g_ptr_array_new_with_free_func (g_free);
+    g_ptr_array_add (samples, build_sample (pages, "report"));
+  }
+
+  json = build_json (samples);
+  if (!pt_util_write_output (output, json, &err))
+    g_warning ("Failed to write memory report to %s: %s", output, err->message);
+}
+
+/**
+ * pt_memory_dump:
+ *
+ * Writes the recorded memory samples as JSON.
+ */
+void
+pt_memory_dump (void)
+{
+  g_autofree char *json = NULL;
+  g_autoptr (GError) err = NULL;
+
+  if (!memory.samples)
+    return;
+
+  pt_memory_sample (NULL, "exit");
+
+  json = build_json (memory.samples);
+  if (!pt_util_write_output (memory.output, json, &err))
+    g_warning ("Failed to write memory samples to %s: %s", memory.output, err->message);
+
+  g_clear_pointer (&memory.samples, g_ptr_array_unref);
+  g_clear_pointer (&memory.output, g_free);
+}
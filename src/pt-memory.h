@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+void     pt_memory_init       (void);
+gboolean pt_memory_is_enabled (void);
+void     pt_memory_sample     (GPtrArray  *pages,
+                               const char *format,
+                               ...) G_GNUC_PRINTF (2, 3);
+void     pt_memory_report     (GPtrArray  *pages);
+void     pt_memory_dump       (void);
+
+G_END_DECLS
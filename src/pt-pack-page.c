@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-pack-page"
+
+#include "phosh-tour-config.h"
+
+#include "pt-pack-page.h"
+
+/**
+ * PtPackPage:
+ *
+ * A tour page from a drop-in page pack (see `pt-page-packs.c`). Only
+ * the path of the page's definition is known up front. Summary,
+ * explanation and image are read from it once the page gets
+ * materialized. Summary and explanation can be localized the same
+ * way as in desktop files.
+ */
+
+enum {
+  PROP_0,
+  PROP_PATH,
+  PROP_LAST_PROP
+};
+static GParamSpec *props[PROP_LAST_PROP];
+
+struct _PtPackPage {
+  PtPage       parent;
+
+  char        *path;
+};
+
+G_DEFINE_TYPE (PtPackPage, pt_pack_page, PT_TYPE_PAGE)
+
+
+static char *
+resolve_image (PtPackPage *self, const char *image)
+{
+  g_autofree char *dir = NULL;
+  g_autofree char *path = NULL;
+
+  if (g_uri_peek_scheme (image))
+    return g_strdup (image);
+
+  if (g_path_is_absolute (image))
+    return g_filename_to_uri (image, NULL, NULL);
+
+  /* Relative to the page's definition */
+  dir = g_path_get_dirname (self->path);
+  path = g_build_filename (dir, image, NULL);
+  return g_filename_to_uri (path, NULL, NULL);
+}
+
+
+static void
+pt_pack_page_load (PtPage *page)
+{
+  PtPackPage *self = PT_PACK_PAGE (page);
+  g_autoptr (GKeyFile) keyfile = g_key_file_new ();
+  g_autoptr (GError) err = NULL;
+  g_autofree char *summary = NULL;
+  g_autofree char *explanation = NULL;
+  g_autofree char *image = NULL;
+
+  if (!g_key_file_load_from_file (keyfile, self->path, G_KEY_FILE_NONE, &err)) {
+    g_warning ("Failed to load page %s: %s", self->path, err->message);
+    return;
+  }
+
+  summary = g_key_file_get_locale_string (keyfile, PT_PACK_PAGE_GROUP, "Summary", NULL, NULL);
+  explanation = g_key_file_get_locale_string (keyfile, PT_PACK_PAGE_GROUP, "Explanation",
+                                              NULL, NULL);
+  image = g_key_file_get_string (keyfile, PT_PACK_PAGE_GROUP, "Image", NULL);
+
+  pt_page_set_summary (page, summary);
+  pt_page_set_explanation (page, explanation);
+  if (image && image[0]) {
+    g_autofree char *uri = resolve_image (self, image);
+
+    pt_page_set_image_uri (page, uri);
+  }
+}
+
+
+static void
+pt_pack_page_set_property (GObject      *object,
+                           guint         property_id,
+                           const GValue *value,
+                           GParamSpec   *pspec)
+{
+  PtPackPage *self = PT_PACK_PAGE (object);
+
+  switch (property_id) {
+  case PROP_PATH:
+    g_free (self->path);
+    self->path = g_value_dup_string (value);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_pack_page_get_property (GObject    *object,
+                           guint       property_id,
+                           GValue     *value,
+                           GParamSpec *pspec)
+{
+  PtPackPage *self = PT_PACK_PAGE (object);
+
+  switch (property_id) {
+  case PROP_PATH:
+    g_value_set_string (value, self->path);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_pack_page_finalize (GObject *object)
+{
+  PtPackPage *self = PT_PACK_PAGE (object);
+
+  g_clear_pointer (&self->path, g_free);
+
+  G_OBJECT_CLASS (pt_pack_page_parent_class)->finalize (object);
+}
+
+
+static void
+pt_pack_page_class_init (PtPackPageClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  PtPageClass *page_class = PT_PAGE_CLASS (klass);
+
+  object_class->finalize = pt_pack_page_finalize;
+  object_class->set_property = pt_pack_page_set_property;
+  object_class->get_property = pt_pack_page_get_property;
+
+  page_class->load = pt_pack_page_load;
+
+  props[PROP_PATH] =
+    g_param_spec_string ("path", "", "",
+                         NULL,
+                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
+}
+
+
+static void
+pt_pack_page_init (PtPackPage *self)
+{
+}
+
+
+PtPage *
+pt_pack_page_new (const char *page_id, const char *path)
+{
+  return g_object_new (PT_TYPE_PACK_PAGE, "page-id", page_id, "path", path, NULL);
+}
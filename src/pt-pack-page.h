@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <pt-page.h>
+
+G_BEGIN_DECLS
+
+#define PT_PACK_PAGE_GROUP "Page"
+
+#define PT_TYPE_PACK_PAGE (pt_pack_page_get_type ())
+
+G_DECLARE_FINAL_TYPE (PtPackPage, pt_pack_page, PT, PACK_PAGE, PtPage)
+
+PtPage     *pt_pack_page_new      (const char *page_id, const char *path);
+
+G_END_DECLS
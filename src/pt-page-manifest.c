@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-page-manifest"
+
+#include "phosh-tour-config.h"
+
+#include "pt-compatible-matcher.h"
+#include "pt-device.h"
+#include "pt-hw-page.h"
+#include "pt-page.h"
+#include "pt-page-manifest.h"
+#include "pt-trace.h"
+
+#include <glib/gi18n.h>
+
+/*
+ * The page manifest is compiled from the pages in the window's
+ * template at build time (see build-aux/pt-compile-pages.py) so
+ * pages can be constructed without parsing any XML. Strings are
+ * used straight from the (mmapped) resource.
+ *
+ * Summaries and explanations come from per locale tables that are
+ * already translated and branded. There's only a table for each
+ * translation, for any other locale (including "C") they're
+ * translated and branded at runtime.
+ */
+
+#define PT_PAGE_MANIFEST_RESOURCE "/mobi/phosh/PhoshTour/pages.gvariant"
+#define PT_PAGE_MANIFEST_VERSION  3
+#define PT_PAGE_MANIFEST_TYPE     "(ua(ssssssas)a{sa(ss)})"
+
+
+static const char *
+translate (const char *msgid)
+{
+  /* gettext would return the catalog's header otherwise */
+  if (msgid[0] == '\0')
+    return msgid;
+
+  return g_dgettext (GETTEXT_PACKAGE, msgid);
+}
+
+
+static GVariant *
+load_manifest_uncached (GError **error)
+{
+  g_autoptr (GBytes) bytes = NULL;
+  g_autoptr (GVariant) manifest = NULL;
+  guint32 version;
+
+  bytes = g_resources_lookup_data (PT_PAGE_MANIFEST_RESOURCE, G_RESOURCE_LOOKUP_FLAGS_NONE, error);
+  if (bytes == NULL)
+    return NULL;
+
+  /* Produced by our own serializer rather than GLib so don't trust it */
+  manifest = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE (PT_PAGE_MANIFEST_TYPE),
+                                                          bytes,
+                                                          FALSE));
+  /* The manifest is always stored little endian */
+  if (G_BYTE_ORDER == G_BIG_ENDIAN) {
+    GVariant *swapped = g_variant_byteswap (manifest);
+
+    g_variant_unref (manifest);
+    manifest = swapped;
+  }
+
+  g_variant_get_child (manifest, 0, "u", &version);
+  if (version != PT_PAGE_MANIFEST_VERSION) {
+    g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                 "Unsupported page manifest version %u", version);
+    return NULL;
+  }
+
+  return g_steal_pointer (&manifest);
+}
+
+/* Kept for the process' lifetime so pages can use its strings directly */
+static GVariant *
+load_manifest (GError **error)
+{
+  static GVariant *manifest;
+
+  if (manifest == NULL)
+    manifest = load_manifest_uncached (error);
+
+  return manifest;
+}
+
+
+static gboolean
+has_image (const char *image_uri)
+{
+  if (!g_str_has_prefix (image_uri, "resource://"))
+    return TRUE;
+
+  return g_resources_get_info (&image_uri[strlen ("resource://")],
+                               G_RESOURCE_LOOKUP_FLAGS_NONE,
+                               NULL, NULL, NULL);
+}
+
+
+static GVariant *
+lookup_locale_table (GVariant *manifest, gsize n_pages)
+{
+  const char *const *languages = g_get_language_names ();
+  g_autoptr (GVariant) tables = g_variant_get_child_value (manifest, 2);
+
+  for (int i = 0; languages[i]; i++) {
+    GVariant *table = g_variant_lookup_value (tables, languages[i], G_VARIANT_TYPE ("a(ss)"));
+
+    if (table == NULL)
+      continue;
+
+    /* Pages index into the table */
+    if (g_variant_n_children (table) != n_pages) {
+      g_warning ("String table for '%s' has %" G_GSIZE_FORMAT " entries but there are %"
+                 G_GSIZE_FORMAT " pages, ignoring it",
+                 languages[i], g_variant_n_children (table), n_pages);
+      g_variant_unref (table);
+      continue;
+    }
+
+    g_debug ("Using string table for '%s'", languages[i]);
+    return table;
+  }
+
+  return NULL;
+}
+
+/* Match all pages' compatibles against the device in one go, rule ids are page indices */
+static PtCompatibleMatcher *
+match_pages (GVariant *pages_variant)
+{
+  PtCompatibleMatcher *matcher = pt_compatible_matcher_new ();
+  const char **compatibles;
+  GVariantIter iter;
+
+  g_variant_iter_init (&iter, pages_variant);
+  while (g_variant_iter_next (&iter, "(&s&s&s&s&s&s^a&s)",
+                              NULL, NULL, NULL, NULL, NULL, NULL, &compatibles)) {
+    pt_compatible_matcher_add_rule (matcher, compatibles);
+    g_free (compatibles);
+  }
+  pt_compatible_matcher_match (matcher, pt_device_get_compatibles ());
+
+  return matcher;
+}
+
+/*
+ * Whether a page applies to the device. Hardware specific pages need
+ * to match the device and have their asset bundle installed. Shared by
+ * building pages and getting their ids so run-once counts exactly the
+ * pages that get shown.
+ */
+static gboolean
+page_applies (PtCompatibleMatcher *matcher,
+              gsize                page_index,
+              const char          *type_name,
+              const char          *image_uri)
+{
+  /* Compare by name, looking up the type would need the toolkit */
+  if (!g_str_equal (type_name, "PtHwPage"))
+    return TRUE;
+
+  if (!pt_compatible_matcher_get_result (matcher, page_index))
+    return FALSE;
+
+  /* The page's assets come with a separately installed bundle */
+  if (!has_image (image_uri)) {
+    g_debug ("No bundle providing %s, skipping page", image_uri);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * pt_page_manifest_build_pages:
+ * @error: Return location for an error
+ *
+ * Builds the tour's pages from the compiled page manifest. Hardware
+ * specific pages that don't apply to the device or whose asset bundle
+ * isn't installed aren't constructed at all. The pages are
+ * placeholders until materialized.
+ *
+ * Returns:(transfer full): The pages
+ */
+GPtrArray *
+pt_page_manifest_build_pages (GError **error)
+{
+  GVariant *manifest;
+  g_autoptr (GVariant) pages_variant = NULL;
+  g_autoptr (GVariant) table = NULL;
+  g_autoptr (GPtrArray) pages = NULL;
+  g_autoptr (PtCompatibleMatcher) matcher = NULL;
+  const char *type_name, *page_id, *image_uri, *summary, *explanation, *widget_ui;
+  const char **compatibles;
+  GVariantIter iter;
+  int skipped = 0;
+  gsize index = 0;
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+  gint64 filter_begin G_GNUC_UNUSED;
+
+  g_type_ensure (PT_TYPE_PAGE);
+  g_type_ensure (PT_TYPE_HW_PAGE);
+
+  manifest = load_manifest (error);
+  if (manifest == NULL)
+    return NULL;
+
+  pt_device_load_bundles ();
+
+  pages = g_ptr_array_new_with_free_func (g_object_unref);
+  pages_variant = g_variant_get_child_value (manifest, 1);
+  table = lookup_locale_table (manifest, g_variant_n_children (pages_variant));
+
+  filter_begin = PT_TRACE_NOW ();
+  matcher = match_pages (pages_variant);
+  PT_TRACE_MARK (filter_begin, "page-filter", "match compatibles");
+
+  g_variant_iter_init (&iter, pages_variant);
+  while (g_variant_iter_next (&iter, "(&s&s&s&s&s&s^a&s)",
+                              &type_name, &page_id, &image_uri, &summary, &explanation,
+                              &widget_ui, &compatibles)) {
+    g_autofree const char **page_compatibles = compatibles;
+    GType type = g_type_from_name (type_name);
+    gsize page_index = index++;
+    PtPage *page;
+
+    if (!g_type_is_a (type, PT_TYPE_PAGE)) {
+      g_warning ("Ignoring page of unknown type '%s'", type_name);
+      continue;
+    }
+
+    if (!page_applies (matcher, page_index, type_name, image_uri)) {
+      skipped++;
+      continue;
+    }
+
+    page = g_object_new (type,
+                         "page-id", page_id,
+                         "image-uri", image_uri[0] ? image_uri : NULL,
+                         NULL);
+    if (table) {
+      g_variant_get_child (table, page_index, "(&s&s)", &summary, &explanation);
+      pt_page_set_static_text (page, summary, explanation);
+    } else {
+      pt_page_set_summary (page, translate (summary));
+      pt_page_set_explanation (page, translate (explanation));
+    }
+    if (PT_IS_HW_PAGE (page))
+      g_object_set (page, "compatibles", page_compatibles, NULL);
+
+    /* Only built when the page gets materialized */
+    if (widget_ui[0])
+      pt_page_set_widget_ui (page, widget_ui);
+
+    g_ptr_array_add (pages, g_object_ref_sink (page));
+  }
+
+  g_debug ("Built %u page(s), skipped %d hw specific page(s)", pages->len, skipped);
+  PT_TRACE_MARK (begin, "build-pages", "%u pages, %d skipped", pages->len, skipped);
+
+  return g_steal_pointer (&pages);
+}
+
+/**
+ * pt_page_manifest_get_page_ids:
+ * @error: Return location for an error
+ *
+ * Gets the ids of the pages that apply to the device without
+ * constructing any of them. These are the pages
+ * [func@page_manifest_build_pages] builds. This doesn't need the
+ * toolkit to be initialized.
+ *
+ * Returns:(transfer full): The page ids
+ */
+GStrv
+pt_page_manifest_get_page_ids (GError **error)
+{
+  GVariant *manifest;
+  g_autoptr (GVariant) pages_variant = NULL;
+  g_autoptr (PtCompatibleMatcher) matcher = NULL;
+  g_autoptr (GStrvBuilder) builder = NULL;
+  const char *type_name, *page_id, *image_uri;
+  GVariantIter iter;
+  guint index = 0;
+
+  manifest = load_manifest (error);
+  if (manifest == NULL)
+    return NULL;
+
+  pt_device_load_bundles ();
+
+  pages_variant = g_variant_get_child_value (manifest, 1);
+  matcher = match_pages (pages_variant);
+  builder = g_strv_builder_new ();
+
+  g_variant_iter_init (&iter, pages_variant);
+  while (g_variant_iter_next (&iter, "(&s&s&s&s&s&s@as)",
+                              &type_name, &page_id, &image_uri, NULL, NULL, NULL, NULL)) {
+    guint page_index = index++;
+
+    if (!page_applies (matcher, page_index, type_name, image_uri))
+      continue;
+
+    g_strv_builder_add (builder, page_id);
+  }
+
+  return g_strv_builder_end (builder);
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+GPtrArray *pt_page_manifest_build_pages  (GError **error);
+GStrv      pt_page_manifest_get_page_ids (GError **error);
+
+G_END_DECLS
@@ -0,0 +1,493 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-page-packs"
+
+#include "phosh-tour-config.h"
+
+#include "pt-compatible-matcher.h"
+#include "pt-device.h"
+#include "pt-pack-page.h"
+#include "pt-page.h"
+#include "pt-page-packs.h"
+#include "pt-trace.h"
+
+#include <glib/gstdio.h>
+
+#include <errno.h>
+
+/*
+ * Page packs let vendors and distributions add, replace, move or
+ * hide pages without rebuilding. Each page is a key file ending in
+ * `.page` in `PHOSH_TOUR_PAGES_DIR` (overridable via the environment
+ * variable of the same name):
+ *
+ *   [Page]
+ *   Id=my-page
+ *   Summary=Summary
+ *   Summary[de]=Zusammenfassung
+ *   Explanation=A longer explanation
+ *   Image=my-page.svg
+ *   After=welcome
+ *   Compatibles=vendor,device;
+ *
+ * `Image` is relative to the page's file unless it's an absolute path
+ * or URI. The page is put before the page named by `Before` or after
+ * the one named by `After`. A page without `Summary` that uses the
+ * id of an existing page only moves it, `Hidden=true` removes it. A
+ * page using the id of an existing page otherwise replaces it. New
+ * pages are put before the final page by default. If `Compatibles` is
+ * given the page is only shown on matching devices. Files are
+ * processed in alphabetical order. The built-in pages are the
+ * default pack everything else applies to.
+ *
+ * To not parse all files on each start the directory is summarized
+ * into a binary index in the user's cache directory that holds just
+ * what's needed to order and filter the pages. The index is validated
+ * against the modification times of the directory and the files. The
+ * rest of a page's definition is only read once the page gets
+ * materialized (see [class@PackPage]).
+ */
+
+#define PT_PAGE_PACKS_INDEX_VERSION 1
+/* (version, dir, dir-mtime, [(id, path, mtime, size, before, after, [compatibles], flags)]) */
+#define PT_PAGE_PACKS_INDEX_TYPE    "(usxa(ssxtssasu))"
+#define PT_PAGE_PACKS_ENTRY_TYPE    "a(ssxtssasu)"
+
+typedef enum {
+  PT_PACK_ENTRY_FLAG_NONE    = 0,
+  PT_PACK_ENTRY_FLAG_CONTENT = 1 << 0,
+  PT_PACK_ENTRY_FLAG_HIDDEN  = 1 << 1,
+} PtPackEntryFlags;
+
+
+static gboolean
+stat_file (const char *path, gint64 *mtime, guint64 *size)
+{
+  GStatBuf st;
+
+  if (g_stat (path, &st) != 0)
+    return FALSE;
+
+  *mtime = (gint64) st.st_mtim.tv_sec * G_USEC_PER_SEC + st.st_mtim.tv_nsec / 1000;
+  if (size)
+    *size = st.st_size;
+
+  return TRUE;
+}
+
+
+static int
+compare_names (gconstpointer a, gconstpointer b)
+{
+  return g_strcmp0 (*(const char **) a, *(const char **) b);
+}
+
+
+static void
+add_entry (GVariantBuilder *builder, const char *path)
+{
+  static const char *const no_compatibles[] = { NULL };
+  g_autoptr (GKeyFile) keyfile = g_key_file_new ();
+  g_autoptr (GError) err = NULL;
+  g_autofree char *id = NULL;
+  g_autofree char *before = NULL;
+  g_autofree char *after = NULL;
+  g_auto (GStrv) compatibles = NULL;
+  PtPackEntryFlags flags = PT_PACK_ENTRY_FLAG_NONE;
+  gint64 mtime;
+  guint64 size;
+
+  /* Stat first so a concurrent modification invalidates the index */
+  if (!stat_file (path, &mtime, &size))
+    return;
+
+  if (!g_key_file_load_from_file (keyfile, path, G_KEY_FILE_NONE, &err)) {
+    g_warning ("Failed to load page %s: %s", path, err->message);
+    return;
+  }
+
+  id = g_key_file_get_string (keyfile, PT_PACK_PAGE_GROUP, "Id", NULL);
+  if (id == NULL || id[0] == '\0') {
+    g_warning ("Page %s has no Id, ignoring", path);
+    return;
+  }
+
+  before = g_key_file_get_string (keyfile, PT_PACK_PAGE_GROUP, "Before", NULL);
+  after = g_key_file_get_string (keyfile, PT_PACK_PAGE_GROUP, "After", NULL);
+  compatibles = g_key_file_get_string_list (keyfile, PT_PACK_PAGE_GROUP, "Compatibles", NULL, NULL);
+  if (g_key_file_has_key (keyfile, PT_PACK_PAGE_GROUP, "Summary", NULL))
+    flags |= PT_PACK_ENTRY_FLAG_CONTENT;
+  if (g_key_file_get_boolean (keyfile, PT_PACK_PAGE_GROUP, "Hidden", NULL))
+    flags |= PT_PACK_ENTRY_FLAG_HIDDEN;
+
+  g_variant_builder_add (builder, "(ssxtss^asu)",
+                         id,
+                         path,
+                         mtime,
+                         size,
+                         before ?: "",
+                         after ?: "",
+                         compatibles ? (const char *const *) compatibles : no_compatibles,
+                         flags);
+}
+
+
+static GVariant *
+build_index (const char *dir)
+{
+  g_autoptr (GDir) gdir = NULL;
+  g_autoptr (GPtrArray) names = NULL;
+  g_autoptr (GError) err = NULL;
+  GVariantBuilder builder;
+  const char *name;
+  gint64 dir_mtime;
+
+  /* Before listing so files added meanwhile invalidate the index */
+  if (!stat_file (dir, &dir_mtime, NULL))
+    return NULL;
+
+  gdir = g_dir_open (dir, 0, &err);
+  if (gdir == NULL) {
+    g_warning ("Failed to open %s: %s", dir, err->message);
+    return NULL;
+  }
+
+  names = g_ptr_array_new_with_free_func (g_free);
+  while ((name = g_dir_read_name (gdir))) {
+    if (g_str_has_suffix (name, ".page"))
+      g_ptr_array_add (names, g_strdup (name));
+  }
+  g_ptr_array_sort (names, compare_names);
+
+  g_variant_builder_init (&builder, G_VARIANT_TYPE (PT_PAGE_PACKS_ENTRY_TYPE));
+  for (guint i = 0; i < names->len; i++) {
+    g_autofree char *path = g_build_filename (dir, g_ptr_array_index (names, i), NULL);
+
+    add_entry (&builder, path);
+  }
+
+  return g_variant_ref_sink (g_variant_new ("(usx@" PT_PAGE_PACKS_ENTRY_TYPE ")",
+                                            PT_PAGE_PACKS_INDEX_VERSION,
+                                            dir,
+                                            dir_mtime,
+                                            g_variant_builder_end (&builder)));
+}
+
+
+static void
+save_index (GVariant *index, const char *index_path)
+{
+  g_autofree char *dir = g_path_get_dirname (index_path);
+  g_autoptr (GError) err = NULL;
+
+  if (g_mkdir_with_parents (dir, 0755) != 0) {
+    g_warning ("Failed to create %s: %s", dir, g_strerror (errno));
+    return;
+  }
+
+  if (!g_file_set_contents (index_path,
+                            g_variant_get_data (index),
+                            g_variant_get_size (index),
+                            &err)) {
+    g_warning ("Failed to save page pack index: %s", err->message);
+  }
+}
+
+
+static GVariant *
+load_index (const char *index_path)
+{
+  g_autoptr (GMappedFile) file = NULL;
+  g_autoptr (GBytes) bytes = NULL;
+  g_autoptr (GError) err = NULL;
+
+  file = g_mapped_file_new (index_path, FALSE, &err);
+  if (file == NULL) {
+    if (!g_error_matches (err, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+      g_debug ("Failed to load page pack index: %s", err->message);
+    return NULL;
+  }
+
+  /* Untrusted, invalid data reads as default values */
+  bytes = g_mapped_file_get_bytes (file);
+  return g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE (PT_PAGE_PACKS_INDEX_TYPE),
+                                                      bytes,
+                                                      FALSE));
+}
+
+
+static gboolean
+index_is_valid (GVariant *index, const char *dir)
+{
+  g_autoptr (GVariant) entries = NULL;
+  const char *index_dir, *path;
+  gint64 index_mtime, mtime;
+  guint64 index_size, size;
+  guint32 version;
+  GVariantIter iter;
+
+  /* The index is in host byte order, a swapped version number won't match either */
+  g_variant_get_child (index, 0, "u", &version);
+  if (version != PT_PAGE_PACKS_INDEX_VERSION)
+    return FALSE;
+
+  g_variant_get_child (index, 1, "&s", &index_dir);
+  if (!g_str_equal (index_dir, dir))
+    return FALSE;
+
+  g_variant_get_child (index, 2, "x", &index_mtime);
+  if (!stat_file (dir, &mtime, NULL) || mtime != index_mtime)
+    return FALSE;
+
+  entries = g_variant_get_child_value (index, 3);
+  g_variant_iter_init (&iter, entries);
+  while (g_variant_iter_next (&iter, "(&s&sxt&s&s@asu)",
+                              NULL, &path, &index_mtime, &index_size, NULL, NULL, NULL, NULL)) {
+    if (!stat_file (path, &mtime, &size) || mtime != index_mtime || size != index_size)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+
+static GVariant *
+get_index (const char *dir, const char *index_path)
+{
+  g_autoptr (GVariant) index = load_index (index_path);
+
+  if (index && index_is_valid (index, dir))
+    return g_steal_pointer (&index);
+
+  g_clear_pointer (&index, g_variant_unref);
+  index = build_index (dir);
+  if (index == NULL)
+    return NULL;
+
+  g_debug ("Rebuilt page pack index for %s", dir);
+  save_index (index, index_path);
+
+  return g_steal_pointer (&index);
+}
+
+
+static int
+find_page (GPtrArray *pages, const char *page_id)
+{
+  for (guint i = 0; i < pages->len; i++) {
+    if (g_strcmp0 (pt_page_get_page_id (g_ptr_array_index (pages, i)), page_id) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
+
+static guint
+get_insert_pos (GPtrArray *pages, const char *before, const char *after, int pos)
+{
+  int anchor;
+
+  if (before[0]) {
+    anchor = find_page (pages, before);
+    if (anchor >= 0)
+      return anchor;
+    g_debug ("No page '%s' to insert before", before);
+  }
+
+  if (after[0]) {
+    anchor = find_page (pages, after);
+    if (anchor >= 0)
+      return anchor + 1;
+    g_debug ("No page '%s' to insert after", after);
+  }
+
+  if (pos >= 0)
+    return pos;
+
+  /* Keep the final page last */
+  return MAX ((int) pages->len - 1, 0);
+}
+
+/* Rule ids of the returned matcher are entry indices */
+static GVariant *
+get_entries (const char *dir, const char *index_path, PtCompatibleMatcher **matcher)
+{
+  g_autoptr (GVariant) index = NULL;
+  GVariant *entries;
+  const char **compatibles;
+  GVariantIter iter;
+
+  index = get_index (dir, index_path);
+  if (index == NULL)
+    return NULL;
+
+  entries = g_variant_get_child_value (index, 3);
+
+  *matcher = pt_compatible_matcher_new ();
+  g_variant_iter_init (&iter, entries);
+  while (g_variant_iter_next (&iter, "(&s&sxt&s&s^a&su)",
+                              NULL, NULL, NULL, NULL, NULL, NULL, &compatibles, NULL)) {
+    pt_compatible_matcher_add_rule (*matcher, compatibles);
+    g_free (compatibles);
+  }
+  pt_compatible_matcher_match (*matcher, pt_device_get_compatibles ());
+
+  return entries;
+}
+
+
+static char *
+get_default_index_path (void)
+{
+  return g_build_filename (g_get_user_cache_dir (), "phosh-tour", "page-packs.gvariant", NULL);
+}
+
+
+static const char *
+get_default_dir (void)
+{
+  return g_getenv ("PHOSH_TOUR_PAGES_DIR") ?: PHOSH_TOUR_PAGES_DIR;
+}
+
+/**
+ * pt_page_packs_merge:
+ * @pages: The pages to merge into
+ * @dir: The directory with the page packs
+ * @index_path: Where to cache the directory's index
+ *
+ * Adds, replaces, moves and hides @pages according to the page packs
+ * in @dir. Added pages are placeholders until materialized.
+ */
+void
+pt_page_packs_merge (GPtrArray *pages, const char *dir, const char *index_path)
+{
+  g_autoptr (GVariant) entries = NULL;
+  g_autoptr (PtCompatibleMatcher) matcher = NULL;
+  const char *page_id, *path, *before, *after;
+  const char **compatibles;
+  guint32 flags;
+  GVariantIter iter;
+  guint rule = 0;
+  int skipped = 0;
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+
+  g_return_if_fail (pages != NULL);
+  g_return_if_fail (dir != NULL);
+  g_return_if_fail (index_path != NULL);
+
+  entries = get_entries (dir, index_path, &matcher);
+  if (entries == NULL)
+    return;
+
+  g_variant_iter_init (&iter, entries);
+  while (g_variant_iter_next (&iter, "(&s&sxt&s&s^a&su)",
+                              &page_id, &path, NULL, NULL, &before, &after, &compatibles, &flags)) {
+    g_autofree const char **page_compatibles = compatibles;
+    guint entry = rule++;
+    PtPage *page;
+    int pos;
+
+    if (page_compatibles[0] && !pt_compatible_matcher_get_result (matcher, entry)) {
+      skipped++;
+      continue;
+    }
+
+    pos = find_page (pages, page_id);
+    if (flags & PT_PACK_ENTRY_FLAG_HIDDEN) {
+      if (pos >= 0)
+        g_ptr_array_remove_index (pages, pos);
+      continue;
+    }
+
+    if (flags & PT_PACK_ENTRY_FLAG_CONTENT) {
+      page = g_object_ref_sink (pt_pack_page_new (page_id, path));
+    } else if (pos >= 0) {
+      page = g_object_ref (g_ptr_array_index (pages, pos));
+    } else {
+      g_warning ("Page %s has no Summary, ignoring", path);
+      continue;
+    }
+
+    if (pos >= 0)
+      g_ptr_array_remove_index (pages, pos);
+
+    g_ptr_array_insert (pages, get_insert_pos (pages, before, after, pos), page);
+  }
+
+  g_debug ("Merged page packs from %s, skipped %d hw specific page(s)", dir, skipped);
+  PT_TRACE_MARK (begin, "page-packs", "%s", dir);
+}
+
+/**
+ * pt_page_packs_add_pages:
+ * @pages: The pages to merge into
+ *
+ * Like [func@page_packs_merge] but using the system's page packs
+ * and the user's cache directory for the index.
+ */
+void
+pt_page_packs_add_pages (GPtrArray *pages)
+{
+  g_autofree char *index_path = get_default_index_path ();
+
+  pt_page_packs_merge (pages, get_default_dir (), index_path);
+}
+
+/**
+ * pt_page_packs_get_page_ids:
+ * @page_ids: The ids of the built-in pages
+ *
+ * Applies the system's page packs to @page_ids like
+ * [func@page_packs_add_pages] does to pages but without constructing
+ * any. The order of the ids isn't meaningful.
+ *
+ * Returns:(transfer full): The resulting page ids
+ */
+GStrv
+pt_page_packs_get_page_ids (const char *const *page_ids)
+{
+  g_autofree char *index_path = get_default_index_path ();
+  g_autoptr (GVariant) entries = NULL;
+  g_autoptr (PtCompatibleMatcher) matcher = NULL;
+  g_autoptr (GPtrArray) ids = NULL;
+  const char *page_id;
+  const char **compatibles;
+  guint32 flags;
+  GVariantIter iter;
+  guint rule = 0;
+
+  ids = g_ptr_array_new_with_free_func (g_free);
+  for (int i = 0; page_ids[i]; i++)
+    g_ptr_array_add (ids, g_strdup (page_ids[i]));
+
+  entries = get_entries (get_default_dir (), index_path, &matcher);
+  if (entries) {
+    g_variant_iter_init (&iter, entries);
+    while (g_variant_iter_next (&iter, "(&s&sxt&s&s^a&su)",
+                                &page_id, NULL, NULL, NULL, NULL, NULL, &compatibles, &flags)) {
+      g_autofree const char **page_compatibles = compatibles;
+      guint entry = rule++;
+      guint pos;
+      gboolean found;
+
+      if (page_compatibles[0] && !pt_compatible_matcher_get_result (matcher, entry))
+        continue;
+
+      found = g_ptr_array_find_with_equal_func (ids, page_id, g_str_equal, &pos);
+      if (flags & PT_PACK_ENTRY_FLAG_HIDDEN) {
+        if (found)
+          g_ptr_array_remove_index_fast (ids, pos);
+      } else if (!found && (flags & PT_PACK_ENTRY_FLAG_CONTENT)) {
+        g_ptr_array_add (ids, g_strdup (page_id));
+      }
+    }
+  }
+
+  g_ptr_array_add (ids, NULL);
+  return (GStrv) g_ptr_array_free (g_steal_pointer (&ids), FALSE);
+}
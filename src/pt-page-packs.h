@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+void  pt_page_packs_merge        (GPtrArray         *pages,
+                                  const char        *dir,
+                                  const char        *index_path);
+void  pt_page_packs_add_pages    (GPtrArray         *pages);
+GStrv pt_page_packs_get_page_ids (const char *const *page_ids);
+
+G_END_DECLS
@@ -10,12 +10,46 @@
 
 #include "phosh-tour-config.h"
 #include "pt-page.h"
+#include "pt-image-loader.h"
+#include "pt-sprite-paintable.h"
+#include "pt-timings.h"
+#include "pt-trace.h"
 
 #include <adwaita.h>
 #include <glib/gi18n.h>
 
+/**
+ * PtPage:
+ *
+ * A page of the tour. To keep startup fast the page's widgets are
+ * only built once [method@Page.materialize] is invoked. Until then
+ * the page is an empty placeholder that only records its properties.
+ * Subclasses can implement the `load` vfunc to only then fill in the
+ * page's contents.
+ *
+ * Images are decoded off the main thread. Until they're ready an empty
+ * placeholder of the typical illustration size is shown. To keep memory
+ * usage in check the image can be released via
+ * [method@Page.unload_image] and loaded again via
+ * [method@Page.ensure_image].
+ *
+ * Animated illustrations only play while the page is set to playing
+ * via [method@Page.set_playing], otherwise they show a still image.
+ *
+ * While [method@Page.set_cache_snapshot] is enabled (e.g. during page
+ * transitions) the page's rendering is recorded once and replayed as
+ * long as its size, scale, style and contents stay the same. Only
+ * pages with static content are cached: pages with a custom widget
+ * are always snapshotted as their children can redraw at any time
+ * (e.g. on hover or focus) without the page noticing.
+ */
+
+#define PT_PAGE_IMAGE_WIDTH  240
+#define PT_PAGE_IMAGE_HEIGHT 400
+
 enum {
   PROP_0,
+  PROP_PAGE_ID,
   PROP_SUMMARY,
   PROP_EXPLANATION,
   PROP_IMAGE_URI,
@@ -24,23 +58,183 @@ enum {
 };
 static GParamSpec *props[PROP_LAST_PROP];
 
+enum {
+  IMAGE_LOADED,
+  N_SIGNALS
+};
+static guint signals[N_SIGNALS];
+
 typedef struct _PtPagePrivate {
-  char       *image_uri;
-  GtkPicture *image;
-  GtkLabel   *lbl_summary;
-  GtkLabel   *lbl_explanation;
-  AdwBin     *bin_widget;
+  char          *page_id;
+  /* Either point to the owned copies or to static strings */
+  const char    *summary;
+  const char    *explanation;
+  char          *summary_data;
+  char          *explanation_data;
+  char          *image_uri;
+  GtkWidget     *widget;
+  /* Builds the widget on materialize, a static string */
+  const char    *widget_ui;
+  gboolean       materialized;
+  gboolean       show_image;
+  gboolean       playing;
+  GCancellable  *cancellable;
+  gint64         image_load_begin;
+
+  /* The recorded rendering and what it depends on */
+  gboolean       cache_snapshot;
+  GskRenderNode *snapshot_node;
+  int            snapshot_width;
+  int            snapshot_height;
+  int            snapshot_scale;
+
+  GtkPicture    *image;
+  GtkLabel      *lbl_summary;
+  GtkLabel      *lbl_explanation;
+  AdwBin        *bin_widget;
 } PtPagePrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE (PtPage, pt_page, ADW_TYPE_BIN)
 
 
-static void
-brand_string (GString *string)
+static char *
+brand_string (const char *str)
 {
+  g_autoptr (GString) string = NULL;
+
+  /* Most strings come pre-branded from the page manifest */
+  if (str == NULL || strchr (str, '@') == NULL)
+    return g_strdup (str);
+
+  string = g_string_new (str);
   g_string_replace (string, "@BRAND@", PHOSH_TOUR_BRAND, 0);
   g_string_replace (string, "@VENDOR@", PHOSH_TOUR_VENDOR, 0);
   g_string_replace (string, "@URL@", PHOSH_TOUR_URL, 0);
+
+  return g_string_free (g_steal_pointer (&string), FALSE);
+}
+
+
+static void
+invalidate_snapshot (PtPage *self)
+{
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+
+  g_clear_pointer (&priv->snapshot_node, gsk_render_node_unref);
+}
+
+
+static void
+build_widget (PtPage *self)
+{
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+  g_autoptr (GtkBuilder) builder = gtk_builder_new_from_string (priv->widget_ui, -1);
+  GObject *widget = gtk_builder_get_object (builder, "widget");
+
+  priv->widget_ui = NULL;
+  g_return_if_fail (GTK_IS_WIDGET (widget));
+
+  pt_page_set_widget (self, GTK_WIDGET (widget));
+}
+
+
+static void
+set_paintable (PtPage *self, GdkPaintable *paintable)
+{
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+  GdkPaintable *old = gtk_picture_get_paintable (priv->image);
+
+  invalidate_snapshot (self);
+
+  if (PT_IS_SPRITE_PAINTABLE (old))
+    pt_sprite_paintable_stop (PT_SPRITE_PAINTABLE (old));
+
+  /* Let the loader cache images that are no longer shown */
+  if (old && old != paintable)
+    pt_image_loader_release (old);
+
+  gtk_picture_set_paintable (priv->image, paintable);
+
+  if (priv->playing && PT_IS_SPRITE_PAINTABLE (paintable))
+    pt_sprite_paintable_play (PT_SPRITE_PAINTABLE (paintable), GTK_WIDGET (priv->image));
+}
+
+
+static void
+on_image_loaded (GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  PtPage *self;
+  PtPagePrivate *priv;
+  g_autoptr (GdkPaintable) paintable = NULL;
+  g_autoptr (GError) err = NULL;
+
+  paintable = pt_image_loader_load_finish (res, &err);
+  /* The page might be gone already */
+  if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    return;
+
+  self = PT_PAGE (user_data);
+  priv = pt_page_get_instance_private (self);
+
+  /* Allow to retry failed loads via pt_page_ensure_image () */
+  g_clear_object (&priv->cancellable);
+
+  if (paintable == NULL) {
+    g_warning ("Failed to load image: %s", err->message);
+    return;
+  }
+
+  set_paintable (self, paintable);
+  PT_TRACE_MARK (priv->image_load_begin, "image-load", "%s", priv->image_uri);
+  pt_timings_mark ("page-image %s", priv->image_uri);
+  g_signal_emit (self, signals[IMAGE_LOADED], 0);
+}
+
+
+static void
+pt_page_load_image (PtPage *self)
+{
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+
+  g_cancellable_cancel (priv->cancellable);
+  g_clear_object (&priv->cancellable);
+
+  if (priv->image_uri == NULL || !priv->show_image) {
+    set_paintable (self, NULL);
+    return;
+  }
+
+  /* Keep showing the current image on e.g. scale changes */
+  if (gtk_picture_get_paintable (priv->image) == NULL) {
+    g_autoptr (GdkPaintable) placeholder = NULL;
+
+    placeholder = gdk_paintable_new_empty (PT_PAGE_IMAGE_WIDTH, PT_PAGE_IMAGE_HEIGHT);
+    set_paintable (self, placeholder);
+  }
+
+  priv->cancellable = g_cancellable_new ();
+  priv->image_load_begin = PT_TRACE_NOW ();
+  pt_image_loader_load_async (priv->image_uri,
+                              gtk_widget_get_scale_factor (GTK_WIDGET (self)),
+                              priv->cancellable,
+                              on_image_loaded,
+                              self);
+}
+
+
+static void
+on_scale_factor_changed (PtPage *self)
+{
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+
+  if (!priv->materialized)
+    return;
+
+  /* Released images get loaded at the right scale once needed again */
+  if (priv->cancellable == NULL && pt_page_get_image_size (self) == 0)
+    return;
+
+  pt_page_load_image (self);
 }
 
 
@@ -51,8 +245,13 @@ pt_page_set_property (GObject      *object,
                       GParamSpec   *pspec)
 {
   PtPage *self = PT_PAGE (object);
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
 
   switch (property_id) {
+  case PROP_PAGE_ID:
+    g_free (priv->page_id);
+    priv->page_id = g_value_dup_string (value);
+    break;
   case PROP_SUMMARY:
     pt_page_set_summary (self, g_value_get_string (value));
     break;
@@ -82,17 +281,20 @@ pt_page_get_property (GObject    *object,
   PtPagePrivate *priv = pt_page_get_instance_private (self);
 
   switch (property_id) {
+  case PROP_PAGE_ID:
+    g_value_set_string (value, priv->page_id);
+    break;
   case PROP_SUMMARY:
-    g_value_set_string (value, gtk_label_get_label (priv->lbl_summary));
+    g_value_set_string (value, priv->summary);
     break;
   case PROP_EXPLANATION:
-    g_value_set_string (value, gtk_label_get_label (priv->lbl_explanation));
+    g_value_set_string (value, priv->explanation);
     break;
   case PROP_IMAGE_URI:
     g_value_set_string (value, priv->image_uri);
     break;
   case PROP_WIDGET:
-    g_value_set_object (value, adw_bin_get_child (priv->bin_widget));
+    g_value_set_object (value, priv->widget);
     break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -101,12 +303,107 @@ pt_page_get_property (GObject    *object,
 }
 
 
+static void
+pt_page_snapshot (GtkWidget *widget, GtkSnapshot *snapshot)
+{
+  PtPage *self = PT_PAGE (widget);
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+  GtkSnapshot *child_snapshot;
+  int width = gtk_widget_get_width (widget);
+  int height = gtk_widget_get_height (widget);
+  int scale = gtk_widget_get_scale_factor (widget);
+
+  /* Child redraws bypass us, so custom widgets would show stale content */
+  if (!priv->cache_snapshot || !priv->materialized || priv->widget) {
+    GTK_WIDGET_CLASS (pt_page_parent_class)->snapshot (widget, snapshot);
+    return;
+  }
+
+  if (priv->snapshot_node && priv->snapshot_width == width &&
+      priv->snapshot_height == height && priv->snapshot_scale == scale) {
+    gtk_snapshot_append_node (snapshot, priv->snapshot_node);
+    return;
+  }
+
+  invalidate_snapshot (self);
+
+  child_snapshot = gtk_snapshot_new ();
+  GTK_WIDGET_CLASS (pt_page_parent_class)->snapshot (widget, child_snapshot);
+  priv->snapshot_node = gtk_snapshot_free_to_node (child_snapshot);
+  priv->snapshot_width = width;
+  priv->snapshot_height = height;
+  priv->snapshot_scale = scale;
+
+  if (priv->snapshot_node)
+    gtk_snapshot_append_node (snapshot, priv->snapshot_node);
+}
+
+
+static void
+pt_page_css_changed (GtkWidget *widget, GtkCssStyleChange *change)
+{
+  /* Style or theme changes */
+  invalidate_snapshot (PT_PAGE (widget));
+
+  GTK_WIDGET_CLASS (pt_page_parent_class)->css_changed (widget, change);
+}
+
+
+static void
+pt_page_system_setting_changed (GtkWidget *widget, GtkSystemSetting setting)
+{
+  /* Fonts and font rendering */
+  invalidate_snapshot (PT_PAGE (widget));
+
+  GTK_WIDGET_CLASS (pt_page_parent_class)->system_setting_changed (widget, setting);
+}
+
+
+static void
+pt_page_state_flags_changed (GtkWidget *widget, GtkStateFlags previous_state_flags)
+{
+  invalidate_snapshot (PT_PAGE (widget));
+
+  GTK_WIDGET_CLASS (pt_page_parent_class)->state_flags_changed (widget, previous_state_flags);
+}
+
+
+static void
+pt_page_direction_changed (GtkWidget *widget, GtkTextDirection previous_direction)
+{
+  invalidate_snapshot (PT_PAGE (widget));
+
+  GTK_WIDGET_CLASS (pt_page_parent_class)->direction_changed (widget, previous_direction);
+}
+
+
+static void
+pt_page_dispose (GObject *object)
+{
+  PtPage *self = PT_PAGE (object);
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+
+  g_cancellable_cancel (priv->cancellable);
+  g_clear_object (&priv->cancellable);
+  g_clear_object (&priv->widget);
+  /* Stops playing sprites and hands the image back to the loader */
+  if (priv->image)
+    set_paintable (self, NULL);
+  invalidate_snapshot (self);
+
+  G_OBJECT_CLASS (pt_page_parent_class)->dispose (object);
+}
+
+
 static void
 pt_page_finalize (GObject *object)
 {
   PtPage *self = PT_PAGE (object);
   PtPagePrivate *priv = pt_page_get_instance_private (self);
 
+  g_clear_pointer (&priv->page_id, g_free);
+  g_clear_pointer (&priv->summary_data, g_free);
+  g_clear_pointer (&priv->explanation_data, g_free);
   g_clear_pointer (&priv->image_uri, g_free);
 
   G_OBJECT_CLASS (pt_page_parent_class)->finalize (object);
@@ -119,10 +416,28 @@ pt_page_class_init (PtPageClass *klass)
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
+  object_class->dispose = pt_page_dispose;
   object_class->finalize = pt_page_finalize;
   object_class->set_property = pt_page_set_property;
   object_class->get_property = pt_page_get_property;
 
+  widget_class->snapshot = pt_page_snapshot;
+  widget_class->css_changed = pt_page_css_changed;
+  widget_class->system_setting_changed = pt_page_system_setting_changed;
+  widget_class->state_flags_changed = pt_page_state_flags_changed;
+  widget_class->direction_changed = pt_page_direction_changed;
+
+  /**
+   * PtPage:page-id:
+   *
+   * A stable identifier of the page. Page packs use it to replace,
+   * move or position pages relative to others.
+   */
+  props[PROP_PAGE_ID] =
+    g_param_spec_string ("page-id", "", "",
+                         NULL,
+                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
   props[PROP_SUMMARY] =
     g_param_spec_string ("summary", "", "",
                          NULL,
@@ -145,19 +460,30 @@ pt_page_class_init (PtPageClass *klass)
 
   g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
 
-  gtk_widget_class_set_template_from_resource (widget_class,
-                                               "/mobi/phosh/PhoshTour/ui/pt-page.ui");
-  gtk_widget_class_bind_template_child_private (widget_class, PtPage, image);
-  gtk_widget_class_bind_template_child_private (widget_class, PtPage, lbl_summary);
-  gtk_widget_class_bind_template_child_private (widget_class, PtPage, lbl_explanation);
-  gtk_widget_class_bind_template_child_private (widget_class, PtPage, bin_widget);
+  /**
+   * PtPage::image-loaded:
+   * @self: The page
+   *
+   * Emitted when the page's image got decoded and is shown.
+   */
+  signals[IMAGE_LOADED] = g_signal_new ("image-loaded",
+                                        G_TYPE_FROM_CLASS (klass),
+                                        G_SIGNAL_RUN_LAST,
+                                        0, NULL, NULL, NULL,
+                                        G_TYPE_NONE,
+                                        0);
 }
 
 
 static void
 pt_page_init (PtPage *self)
 {
-  gtk_widget_init_template (GTK_WIDGET (self));
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+
+  priv->show_image = TRUE;
+  gtk_widget_set_hexpand (GTK_WIDGET (self), TRUE);
+
+  g_signal_connect (self, "notify::scale-factor", G_CALLBACK (on_scale_factor_changed), NULL);
 }
 
 
@@ -168,18 +494,33 @@ pt_page_new (void)
 }
 
 
+static void
+update_labels (PtPage *self)
+{
+  PtPagePrivate *priv = pt_page_get_instance_private (self);
+
+  if (!priv->materialized)
+    return;
+
+  invalidate_snapshot (self);
+  gtk_label_set_label (priv->lbl_summary, priv->summary ?: "");
+  gtk_label_set_label (priv->lbl_explanation, priv->explanation ?: "");
+}
+
+
 void
 pt_page_set_summary (PtPage *self, const char *summary)
 {
   PtPagePrivate *priv;
-  g_autoptr (GString) label = g_string_new (summary);
 
   g_return_if_fail (PT_IS_PAGE (self));
   priv = pt_page_get_instance_private (self);
 
-  brand_string (label);
+  g_free (priv->summary_data);
+  priv->summary_data = brand_string (summary);
+  priv->summary = priv->summary_data;
 
-  gtk_label_set_label (priv->lbl_summary, label->str);
+  update_labels (self);
 }
 
 
@@ -187,14 +528,41 @@ void
 pt_page_set_explanation (PtPage *self, const char *explanation)
 {
   PtPagePrivate *priv;
-  g_autoptr (GString) label = g_string_new (explanation);
 
   g_return_if_fail (PT_IS_PAGE (self));
   priv = pt_page_get_instance_private (self);
 
-  brand_string (label);
+  g_free (priv->explanation_data);
+  priv->explanation_data = brand_string (explanation);
+  priv->explanation = priv->explanation_data;
+
+  update_labels (self);
+}
+
+/**
+ * pt_page_set_static_text:
+ * @self: The page
+ * @summary: The summary
+ * @explanation: The explanation
+ *
+ * Sets summary and explanation without copying or branding them. This
+ * is meant for the pre-branded and pre-translated strings from the
+ * page manifest. The strings must outlive the page.
+ */
+void
+pt_page_set_static_text (PtPage *self, const char *summary, const char *explanation)
+{
+  PtPagePrivate *priv;
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  priv = pt_page_get_instance_private (self);
+
+  g_clear_pointer (&priv->summary_data, g_free);
+  g_clear_pointer (&priv->explanation_data, g_free);
+  priv->summary = summary;
+  priv->explanation = explanation;
 
-  gtk_label_set_label (priv->lbl_explanation, label->str);
+  update_labels (self);
 }
 
 
@@ -202,7 +570,6 @@ void
 pt_page_set_image_uri (PtPage *self, const char *uri)
 {
   PtPagePrivate *priv;
-  g_autoptr (GdkTexture) texture = NULL;
 
   g_return_if_fail (PT_IS_PAGE (self));
   priv = pt_page_get_instance_private (self);
@@ -210,10 +577,11 @@ pt_page_set_image_uri (PtPage *self, const char *uri)
   g_free (priv->image_uri);
   priv->image_uri = g_strdup (uri);
 
-  if (priv->image_uri)
-    gtk_picture_set_resource (priv->image, &uri[strlen("resource://")]);
-  else
-    gtk_picture_set_paintable (priv->image, GDK_PAINTABLE (texture));
+  if (!priv->materialized)
+    return;
+
+  set_paintable (self, NULL);
+  pt_page_load_image (self);
 }
 
 
@@ -227,7 +595,298 @@ pt_page_set_widget (PtPage *self, GtkWidget *widget)
 
   priv = pt_page_get_instance_private (self);
 
-  adw_bin_set_child (priv->bin_widget, widget);
+  g_set_object (&priv->widget, widget);
+
+  if (!priv->materialized)
+    return;
 
+  invalidate_snapshot (self);
+  adw_bin_set_child (priv->bin_widget, widget);
   gtk_widget_set_visible (GTK_WIDGET (priv->bin_widget), !!widget);
 }
+
+/**
+ * pt_page_set_widget_ui:
+ * @self: The page
+ * @ui: GtkBuilder UI defining the widget with the id `widget`
+ *
+ * Sets an additional widget like [method@Page.set_widget] but only
+ * builds it once the page gets materialized. @ui isn't copied so it
+ * must stay valid for the page's lifetime, like the strings of the
+ * page manifest.
+ */
+void
+pt_page_set_widget_ui (PtPage *self, const char *ui)
+{
+  PtPagePrivate *priv;
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  g_return_if_fail (ui != NULL);
+
+  priv = pt_page_get_instance_private (self);
+  priv->widget_ui = ui;
+
+  if (priv->materialized)
+    build_widget (self);
+}
+
+/**
+ * pt_page_materialize:
+ * @self: The page
+ *
+ * Builds the page's widgets and loads its image. Does nothing if
+ * the page was already materialized.
+ */
+void
+pt_page_materialize (PtPage *self)
+{
+  PtPagePrivate *priv;
+  g_autoptr (GtkBuilder) builder = NULL;
+  gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  priv = pt_page_get_instance_private (self);
+
+  if (priv->materialized)
+    return;
+
+  g_debug ("Materializing page '%s'", priv->page_id);
+  /* Let subclasses fill in the page's contents lazily */
+  if (PT_PAGE_GET_CLASS (self)->load)
+    PT_PAGE_GET_CLASS (self)->load (self);
+  priv->materialized = TRUE;
+
+  /* Not a template as subclasses need to build the page long after instance init */
+  builder = gtk_builder_new_from_resource ("/mobi/phosh/PhoshTour/ui/pt-page.ui");
+  priv->image = GTK_PICTURE (gtk_builder_get_object (builder, "image"));
+  priv->lbl_summary = GTK_LABEL (gtk_builder_get_object (builder, "lbl_summary"));
+  priv->lbl_explanation = GTK_LABEL (gtk_builder_get_object (builder, "lbl_explanation"));
+  priv->bin_widget = ADW_BIN (gtk_builder_get_object (builder, "bin_widget"));
+  adw_bin_set_child (ADW_BIN (self), GTK_WIDGET (gtk_builder_get_object (builder, "content")));
+
+  update_labels (self);
+  gtk_widget_set_visible (GTK_WIDGET (priv->image), priv->show_image);
+  pt_page_load_image (self);
+
+  if (priv->widget_ui)
+    build_widget (self);
+
+  if (priv->widget) {
+    adw_bin_set_child (priv->bin_widget, priv->widget);
+    gtk_widget_set_visible (GTK_WIDGET (priv->bin_widget), TRUE);
+  }
+
+  PT_TRACE_MARK (begin, "page-materialize", "%s", priv->summary);
+  pt_timings_mark ("page-init %s", priv->image_uri);
+}
+
+
+const char *
+pt_page_get_page_id (PtPage *self)
+{
+  PtPagePrivate *priv;
+
+  g_return_val_if_fail (PT_IS_PAGE (self), NULL);
+  priv = pt_page_get_instance_private (self);
+
+  return priv->page_id;
+}
+
+
+gboolean
+pt_page_is_materialized (PtPage *self)
+{
+  PtPagePrivate *priv;
+
+  g_return_val_if_fail (PT_IS_PAGE (self), FALSE);
+  priv = pt_page_get_instance_private (self);
+
+  return priv->materialized;
+}
+
+
+/**
+ * pt_page_set_show_image:
+ * @self: The page
+ * @show_image: Whether to show the page's image
+ *
+ * Whether the page shows its image. If not the image isn't loaded
+ * at all and the page only shows text.
+ */
+void
+pt_page_set_show_image (PtPage *self, gboolean show_image)
+{
+  PtPagePrivate *priv;
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  priv = pt_page_get_instance_private (self);
+
+  show_image = !!show_image;
+  if (priv->show_image == show_image)
+    return;
+
+  priv->show_image = show_image;
+
+  if (!priv->materialized)
+    return;
+
+  invalidate_snapshot (self);
+  gtk_widget_set_visible (GTK_WIDGET (priv->image), priv->show_image);
+  pt_page_load_image (self);
+}
+
+/**
+ * pt_page_get_image_size:
+ * @self: The page
+ *
+ * Gets the memory used by the page's decoded image.
+ *
+ * Returns: The size of the image's pixel data in bytes, 0 if no
+ *   image is loaded
+ */
+gsize
+pt_page_get_image_size (PtPage *self)
+{
+  PtPagePrivate *priv;
+
+  g_return_val_if_fail (PT_IS_PAGE (self), 0);
+  priv = pt_page_get_instance_private (self);
+
+  if (!priv->materialized)
+    return 0;
+
+  return pt_image_loader_get_paintable_size (gtk_picture_get_paintable (priv->image));
+}
+
+/**
+ * pt_page_unload_image:
+ * @self: The page
+ *
+ * Releases the page's decoded image and cancels any pending load. A
+ * placeholder of the same size is shown instead so the layout doesn't
+ * change.
+ */
+void
+pt_page_unload_image (PtPage *self)
+{
+  PtPagePrivate *priv;
+  g_autoptr (GdkPaintable) placeholder = NULL;
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  priv = pt_page_get_instance_private (self);
+
+  if (!priv->materialized)
+    return;
+
+  g_cancellable_cancel (priv->cancellable);
+  g_clear_object (&priv->cancellable);
+
+  if (pt_page_get_image_size (self) == 0)
+    return;
+
+  g_debug ("Releasing image '%s'", priv->image_uri);
+  placeholder = gdk_paintable_new_empty (PT_PAGE_IMAGE_WIDTH, PT_PAGE_IMAGE_HEIGHT);
+  set_paintable (self, placeholder);
+}
+
+/**
+ * pt_page_ensure_image:
+ * @self: The page
+ *
+ * Loads the page's image again if it got released via
+ * [method@Page.unload_image]. Does nothing if the page isn't
+ * materialized or the image is already loaded or loading.
+ */
+void
+pt_page_ensure_image (PtPage *self)
+{
+  PtPagePrivate *priv;
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  priv = pt_page_get_instance_private (self);
+
+  if (!priv->materialized || !priv->show_image)
+    return;
+
+  if (priv->cancellable || pt_page_get_image_size (self))
+    return;
+
+  pt_page_load_image (self);
+}
+
+/**
+ * pt_page_set_playing:
+ * @self: The page
+ * @playing: Whether to play the page's animation
+ *
+ * Whether an animated illustration should play. Pages that aren't
+ * visible or are in transition should not play so the frame clock
+ * can stay idle.
+ */
+void
+pt_page_set_playing (PtPage *self, gboolean playing)
+{
+  PtPagePrivate *priv;
+  GdkPaintable *paintable;
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  priv = pt_page_get_instance_private (self);
+
+  playing = !!playing;
+  if (priv->playing == playing)
+    return;
+
+  priv->playing = playing;
+
+  if (!priv->materialized)
+    return;
+
+  paintable = gtk_picture_get_paintable (priv->image);
+  if (!PT_IS_SPRITE_PAINTABLE (paintable))
+    return;
+
+  if (playing)
+    pt_sprite_paintable_play (PT_SPRITE_PAINTABLE (paintable), GTK_WIDGET (priv->image));
+  else
+    pt_sprite_paintable_stop (PT_SPRITE_PAINTABLE (paintable));
+}
+
+/**
+ * pt_page_set_cache_snapshot:
+ * @self: The page
+ * @cache_snapshot: Whether to cache the page's rendering
+ *
+ * Whether to record the page's rendering once and replay it as long
+ * as the page's size, scale, style and contents don't change. This
+ * avoids snapshotting the page's widgets on every frame of a page
+ * transition. Pages with a custom widget are never cached. Disabling
+ * it releases the recording.
+ */
+void
+pt_page_set_cache_snapshot (PtPage *self, gboolean cache_snapshot)
+{
+  PtPagePrivate *priv;
+
+  g_return_if_fail (PT_IS_PAGE (self));
+  priv = pt_page_get_instance_private (self);
+
+  cache_snapshot = !!cache_snapshot;
+  if (priv->cache_snapshot == cache_snapshot)
+    return;
+
+  priv->cache_snapshot = cache_snapshot;
+  if (!cache_snapshot)
+    invalidate_snapshot (self);
+}
+
+
+gboolean
+pt_page_get_cache_snapshot (PtPage *self)
+{
+  PtPagePrivate *priv;
+
+  g_return_val_if_fail (PT_IS_PAGE (self), FALSE);
+  priv = pt_page_get_instance_private (self);
+
+  return priv->cache_snapshot;
+}
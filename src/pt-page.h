@@ -16,12 +16,28 @@ G_DECLARE_DERIVABLE_TYPE (PtPage, pt_page, PT, PAGE, AdwBin)
 struct _PtPageClass
 {
   AdwBinClass parent_class;
+
+  void (*load) (PtPage *self);
 };
 
 PtPage          *pt_page_new               (void);
 void             pt_page_set_summary       (PtPage *self, const char *summary);
 void             pt_page_set_explanation   (PtPage *self, const char *explanation);
+void             pt_page_set_static_text   (PtPage     *self,
+                                            const char *summary,
+                                            const char *explanation);
 void             pt_page_set_image_uri     (PtPage *self, const char *uri);
 void             pt_page_set_widget        (PtPage *self, GtkWidget *widget);
+void             pt_page_set_widget_ui     (PtPage *self, const char *ui);
+void             pt_page_materialize       (PtPage *self);
+gboolean         pt_page_is_materialized   (PtPage *self);
+const char      *pt_page_get_page_id       (PtPage *self);
+void             pt_page_set_show_image    (PtPage *self, gboolean show_image);
+gsize            pt_page_get_image_size    (PtPage *self);
+void             pt_page_unload_image      (PtPage *self);
+void             pt_page_ensure_image      (PtPage *self);
+void             pt_page_set_playing       (PtPage *self, gboolean playing);
+void             pt_page_set_cache_snapshot (PtPage *self, gboolean cache_snapshot);
+gboolean         pt_page_get_cache_snapshot (PtPage *self);
 
 G_END_DECLS
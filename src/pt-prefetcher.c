@@ -0,0 +1,386 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-prefetcher"
+
+#include "phosh-tour-config.h"
+
+#include "pt-prefetcher.h"
+
+/**
+ * PtPrefetcher:
+ *
+ * Warms pages before they enter the viewport. The prefetcher watches
+ * the carousel's position, estimates the velocity and direction of
+ * swipes and scroll animations and materializes the pages the user is
+ * heading to together with their images.
+ *
+ * Prefetching happens one page at a time at low priority so input
+ * handling and frame work always take precedence.
+ *
+ * Whether prefetching pays off is tracked via the `hits` and `misses`
+ * properties: a hit is a page that was prefetched before it got
+ * needed, a miss one that had to be built on demand.
+ */
+
+/* How far ahead in time to predict the position */
+#define PREDICTION_HORIZON_SEC 0.25
+/* Weight of the most recent velocity sample */
+#define VELOCITY_SMOOTHING     0.5
+/* Position changes further apart belong to different gestures */
+#define GESTURE_GAP_SEC        0.1
+
+enum {
+  PROP_0,
+  PROP_CAROUSEL,
+  PROP_LOOK_AHEAD,
+  PROP_HITS,
+  PROP_MISSES,
+  PROP_LAST_PROP
+};
+static GParamSpec *props[PROP_LAST_PROP];
+
+enum {
+  PREFETCHED,
+  N_SIGNALS
+};
+static guint signals[N_SIGNALS];
+
+struct _PtPrefetcher {
+  GObject      parent;
+
+  AdwCarousel *carousel;
+  guint        look_ahead;
+
+  double       last_position;
+  gint64       last_time;
+  double       velocity;
+
+  GQueue       queue;
+  guint        idle_id;
+  /* Pages prefetched but not yet needed */
+  GHashTable  *prefetched;
+
+  guint        hits;
+  guint        misses;
+};
+
+G_DEFINE_TYPE (PtPrefetcher, pt_prefetcher, G_TYPE_OBJECT)
+
+
+static gboolean
+prefetch_one (gpointer user_data)
+{
+  PtPrefetcher *self = PT_PREFETCHER (user_data);
+  PtPage *page = g_queue_pop_head (&self->queue);
+
+  if (page == NULL) {
+    self->idle_id = 0;
+    return G_SOURCE_REMOVE;
+  }
+
+  if (!pt_page_is_materialized (page)) {
+    g_debug ("Prefetching page %p", page);
+    pt_page_materialize (page);
+    g_hash_table_add (self->prefetched, page);
+  } else {
+    pt_page_ensure_image (page);
+  }
+  g_signal_emit (self, signals[PREFETCHED], 0, page);
+
+  /* Yield back to the main loop after every page */
+  return G_SOURCE_CONTINUE;
+}
+
+
+static void
+schedule (PtPrefetcher *self, int from, int direction, guint count)
+{
+  int n_pages = adw_carousel_get_n_pages (self->carousel);
+
+  g_queue_clear (&self->queue);
+
+  /* Current page and direct neighbours are handled by the window */
+  for (int i = from + 2 * direction, n = 0;
+       i >= 0 && i < n_pages && n < count;
+       i += direction, n++) {
+    GtkWidget *page = adw_carousel_get_nth_page (self->carousel, i);
+
+    g_queue_push_tail (&self->queue, page);
+  }
+
+  if (g_queue_is_empty (&self->queue) || self->idle_id)
+    return;
+
+  self->idle_id = g_idle_add_full (G_PRIORITY_LOW, prefetch_one, self, NULL);
+  g_source_set_name_by_id (self->idle_id, "[pt-prefetcher] prefetch");
+}
+
+
+static void
+on_position_changed (PtPrefetcher *self)
+{
+  double position = adw_carousel_get_position (self->carousel);
+  gint64 now = g_get_monotonic_time ();
+  double predicted, dt;
+  int current, direction;
+  guint count;
+
+  dt = (now - self->last_time) / (double) G_USEC_PER_SEC;
+  if (dt > GESTURE_GAP_SEC) {
+    self->velocity = 0.0;
+  } else if (dt > 0) {
+    double velocity = (position - self->last_position) / dt;
+
+    self->velocity = VELOCITY_SMOOTHING * velocity + (1.0 - VELOCITY_SMOOTHING) * self->velocity;
+  }
+  self->last_position = position;
+  self->last_time = now;
+
+  if (self->look_ahead < 2 || G_APPROX_VALUE (self->velocity, 0.0, 0.01))
+    return;
+
+  current = (int) (position + 0.5);
+  direction = self->velocity > 0 ? 1 : -1;
+  predicted = position + self->velocity * PREDICTION_HORIZON_SEC;
+
+  /* Faster movement warms more pages ahead, up to the look-ahead */
+  count = CLAMP ((int) ABS (predicted - current) + 1, 1, (int) self->look_ahead - 1);
+
+  schedule (self, current, direction, count);
+}
+
+
+static void
+pt_prefetcher_set_property (GObject      *object,
+                            guint         property_id,
+                            const GValue *value,
+                            GParamSpec   *pspec)
+{
+  PtPrefetcher *self = PT_PREFETCHER (object);
+
+  switch (property_id) {
+  case PROP_CAROUSEL:
+    self->carousel = g_value_dup_object (value);
+    break;
+  case PROP_LOOK_AHEAD:
+    pt_prefetcher_set_look_ahead (self, g_value_get_uint (value));
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_prefetcher_get_property (GObject    *object,
+                            guint       property_id,
+                            GValue     *value,
+                            GParamSpec *pspec)
+{
+  PtPrefetcher *self = PT_PREFETCHER (object);
+
+  switch (property_id) {
+  case PROP_CAROUSEL:
+    g_value_set_object (value, self->carousel);
+    break;
+  case PROP_LOOK_AHEAD:
+    g_value_set_uint (value, self->look_ahead);
+    break;
+  case PROP_HITS:
+    g_value_set_uint (value, self->hits);
+    break;
+  case PROP_MISSES:
+    g_value_set_uint (value, self->misses);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_prefetcher_constructed (GObject *object)
+{
+  PtPrefetcher *self = PT_PREFETCHER (object);
+
+  G_OBJECT_CLASS (pt_prefetcher_parent_class)->constructed (object);
+
+  g_signal_connect_object (self->carousel,
+                           "notify::position",
+                           G_CALLBACK (on_position_changed),
+                           self,
+                           G_CONNECT_SWAPPED);
+}
+
+
+static void
+pt_prefetcher_dispose (GObject *object)
+{
+  PtPrefetcher *self = PT_PREFETCHER (object);
+
+  if (self->carousel)
+    g_debug ("Prefetch hits: %u, misses: %u", self->hits, self->misses);
+
+  g_clear_handle_id (&self->idle_id, g_source_remove);
+  g_queue_clear (&self->queue);
+  g_clear_pointer (&self->prefetched, g_hash_table_destroy);
+  g_clear_object (&self->carousel);
+
+  G_OBJECT_CLASS (pt_prefetcher_parent_class)->dispose (object);
+}
+
+
+static void
+pt_prefetcher_class_init (PtPrefetcherClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->get_property = pt_prefetcher_get_property;
+  object_class->set_property = pt_prefetcher_set_property;
+  object_class->constructed = pt_prefetcher_constructed;
+  object_class->dispose = pt_prefetcher_dispose;
+
+  /**
+   * PtPrefetcher:carousel:
+   *
+   * The carousel holding the pages to prefetch.
+   */
+  props[PROP_CAROUSEL] =
+    g_param_spec_object ("carousel", "", "",
+                         ADW_TYPE_CAROUSEL,
+                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+  /**
+   * PtPrefetcher:look-ahead:
+   *
+   * How many pages ahead of the current one to warm at most. Values
+   * below 2 disable prefetching as the direct neighbours are always
+   * built.
+   */
+  props[PROP_LOOK_AHEAD] =
+    g_param_spec_uint ("look-ahead", "", "",
+                       0, G_MAXUINT, 2,
+                       G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+  /**
+   * PtPrefetcher:hits:
+   *
+   * The number of pages that were prefetched before they were needed.
+   */
+  props[PROP_HITS] =
+    g_param_spec_uint ("hits", "", "",
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+  /**
+   * PtPrefetcher:misses:
+   *
+   * The number of pages that had to be built on demand.
+   */
+  props[PROP_MISSES] =
+    g_param_spec_uint ("misses", "", "",
+                       0, G_MAXUINT, 0,
+                       G_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
+
+  /**
+   * PtPrefetcher::prefetched:
+   * @self: The prefetcher
+   * @page: The page
+   *
+   * Emitted when a page got prefetched.
+   */
+  signals[PREFETCHED] = g_signal_new ("prefetched",
+                                      G_TYPE_FROM_CLASS (klass),
+                                      G_SIGNAL_RUN_LAST,
+                                      0, NULL, NULL, NULL,
+                                      G_TYPE_NONE,
+                                      1,
+                                      PT_TYPE_PAGE);
+}
+
+
+static void
+pt_prefetcher_init (PtPrefetcher *self)
+{
+  self->look_ahead = 2;
+  g_queue_init (&self->queue);
+  self->prefetched = g_hash_table_new (NULL, NULL);
+}
+
+
+PtPrefetcher *
+pt_prefetcher_new (AdwCarousel *carousel, guint look_ahead)
+{
+  return g_object_new (PT_TYPE_PREFETCHER,
+                       "carousel", carousel,
+                       "look-ahead", look_ahead,
+                       NULL);
+}
+
+
+void
+pt_prefetcher_set_look_ahead (PtPrefetcher *self, guint look_ahead)
+{
+  g_return_if_fail (PT_IS_PREFETCHER (self));
+
+  if (self->look_ahead == look_ahead)
+    return;
+
+  self->look_ahead = look_ahead;
+  g_object_notify_by_pspec (G_OBJECT (self), props[PROP_LOOK_AHEAD]);
+}
+
+
+guint
+pt_prefetcher_get_look_ahead (PtPrefetcher *self)
+{
+  g_return_val_if_fail (PT_IS_PREFETCHER (self), 0);
+
+  return self->look_ahead;
+}
+
+/**
+ * pt_prefetcher_account:
+ * @self: The prefetcher
+ * @page: The page that is needed now
+ *
+ * Records whether a page that is about to enter the viewport was
+ * prefetched. Must be invoked before the page gets materialized.
+ */
+void
+pt_prefetcher_account (PtPrefetcher *self, PtPage *page)
+{
+  g_return_if_fail (PT_IS_PREFETCHER (self));
+  g_return_if_fail (PT_IS_PAGE (page));
+
+  if (g_hash_table_remove (self->prefetched, page)) {
+    self->hits++;
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_HITS]);
+  } else if (!pt_page_is_materialized (page)) {
+    self->misses++;
+    g_object_notify_by_pspec (G_OBJECT (self), props[PROP_MISSES]);
+  }
+}
+
+
+guint
+pt_prefetcher_get_hits (PtPrefetcher *self)
+{
+  g_return_val_if_fail (PT_IS_PREFETCHER (self), 0);
+
+  return self->hits;
+}
+
+
+guint
+pt_prefetcher_get_misses (PtPrefetcher *self)
+{
+  g_return_val_if_fail (PT_IS_PREFETCHER (self), 0);
+
+  return self->misses;
+}
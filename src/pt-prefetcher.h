@@ -0,0 +1,26 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "pt-page.h"
+
+#include <adwaita.h>
+
+G_BEGIN_DECLS
+
+#define PT_TYPE_PREFETCHER (pt_prefetcher_get_type ())
+
+G_DECLARE_FINAL_TYPE (PtPrefetcher, pt_prefetcher, PT, PREFETCHER, GObject)
+
+PtPrefetcher *pt_prefetcher_new            (AdwCarousel *carousel, guint look_ahead);
+void          pt_prefetcher_set_look_ahead (PtPrefetcher *self, guint look_ahead);
+guint         pt_prefetcher_get_look_ahead (PtPrefetcher *self);
+void          pt_prefetcher_account        (PtPrefetcher *self, PtPage *page);
+guint         pt_prefetcher_get_hits       (PtPrefetcher *self);
+guint         pt_prefetcher_get_misses     (PtPrefetcher *self);
+
+G_END_DECLS
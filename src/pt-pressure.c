@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-pressure"
+
+#include "phosh-tour-config.h"
+
+#include "pt-pressure.h"
+
+#include <gio/gio.h>
+
+#include <string.h>
+
+#define PT_PRESSURE_DEFAULT_DIR "/proc/pressure"
+#define PT_PRESSURE_SOME_AVG10 "some avg10="
+
+/*
+ * Helpers to read the kernel's pressure stall information (PSI) and
+ * wait for it to settle so the tour doesn't compete with the rest of
+ * the session for CPU, IO and memory while that is still starting.
+ *
+ * PSI updates its averages every two seconds so waiting polls rather
+ * than using PSI triggers which only fire on rising pressure.
+ */
+
+typedef struct {
+  const char       *dir;
+  const PtPressure *thresholds;
+  GMainLoop        *loop;
+  gboolean          settled;
+} PtPressureWaitData;
+
+/**
+ * pt_pressure_get_default_dir:
+ *
+ * Gets the directory holding the pressure files. It can be overridden
+ * via the `PHOSH_TOUR_PRESSURE_DIR` environment variable.
+ *
+ * Returns: The directory
+ */
+const char *
+pt_pressure_get_default_dir (void)
+{
+  const char *dir = g_getenv ("PHOSH_TOUR_PRESSURE_DIR");
+
+  if (dir && dir[0] != '\0')
+    return dir;
+
+  return PT_PRESSURE_DEFAULT_DIR;
+}
+
+
+static gboolean
+read_avg10 (const char *dir, const char *resource, double *avg10, GError **err)
+{
+  g_autofree char *path = g_build_filename (dir, resource, NULL);
+  g_autofree char *contents = NULL;
+  const char *value;
+  char *end;
+
+  if (!g_file_get_contents (path, &contents, NULL, err))
+    return FALSE;
+
+  if (!g_str_has_prefix (contents, PT_PRESSURE_SOME_AVG10)) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                 "Unexpected pressure data in %s", path);
+    return FALSE;
+  }
+
+  value = contents + strlen (PT_PRESSURE_SOME_AVG10);
+  *avg10 = g_ascii_strtod (value, &end);
+  if (end == value) {
+    g_set_error (err, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+                 "Invalid avg10 in %s", path);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * pt_pressure_read:
+ * @dir: The directory holding the pressure files
+ * @pressure: (out): The current pressure
+ * @err: The return location for errors
+ *
+ * Reads the current CPU, IO and memory pressure.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE (e.g. when the kernel
+ *   lacks PSI support)
+ */
+gboolean
+pt_pressure_read (const char *dir, PtPressure *pressure, GError **err)
+{
+  g_return_val_if_fail (dir, FALSE);
+  g_return_val_if_fail (pressure, FALSE);
+
+  if (!read_avg10 (dir, "cpu", &pressure->cpu, err))
+    return FALSE;
+
+  if (!read_avg10 (dir, "io", &pressure->io, err))
+    return FALSE;
+
+  return read_avg10 (dir, "memory", &pressure->memory, err);
+}
+
+/**
+ * pt_pressure_exceeds:
+ * @pressure: The pressure
+ * @thresholds: The thresholds
+ *
+ * Checks whether any of @pressure's values is above its threshold.
+ *
+ * Returns: %TRUE if any value is above its threshold
+ */
+gboolean
+pt_pressure_exceeds (const PtPressure *pressure, const PtPressure *thresholds)
+{
+  return pressure->cpu > thresholds->cpu ||
+    pressure->io > thresholds->io ||
+    pressure->memory > thresholds->memory;
+}
+
+
+/* Reading fails without PSI support, don't wait for what we can't see */
+static gboolean
+check_settled (PtPressureWaitData *data)
+{
+  g_autoptr (GError) err = NULL;
+  PtPressure pressure;
+
+  if (!pt_pressure_read (data->dir, &pressure, &err)) {
+    g_debug ("Can't read pressure: %s", err->message);
+    return TRUE;
+  }
+
+  if (pt_pressure_exceeds (&pressure, data->thresholds)) {
+    g_debug ("Pressure cpu: %.2f%%, io: %.2f%%, memory: %.2f%%, waiting",
+             pressure.cpu, pressure.io, pressure.memory);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+
+static gboolean
+on_poll_timeout (gpointer user_data)
+{
+  PtPressureWaitData *data = user_data;
+
+  if (!check_settled (data))
+    return G_SOURCE_CONTINUE;
+
+  data->settled = TRUE;
+  g_main_loop_quit (data->loop);
+
+  return G_SOURCE_REMOVE;
+}
+
+
+static gboolean
+on_max_wait_timeout (gpointer user_data)
+{
+  PtPressureWaitData *data = user_data;
+
+  g_main_loop_quit (data->loop);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * pt_pressure_wait:
+ * @dir: The directory holding the pressure files
+ * @thresholds: The thresholds pressure needs to drop below
+ * @interval_ms: How often to check pressure
+ * @max_wait_ms: How long to wait at most
+ *
+ * Blocks until the pressure dropped below @thresholds or
+ * @max_wait_ms passed. Only sources of its own are dispatched
+ * meanwhile so this can be used before the toolkit is initialized.
+ *
+ * Returns: %TRUE if pressure settled, %FALSE if waiting timed out
+ */
+gboolean
+pt_pressure_wait (const char       *dir,
+                  const PtPressure *thresholds,
+                  guint             interval_ms,
+                  guint             max_wait_ms)
+{
+  g_autoptr (GMainContext) context = NULL;
+  g_autoptr (GMainLoop) loop = NULL;
+  g_autoptr (GSource) poll_source = NULL;
+  g_autoptr (GSource) max_wait_source = NULL;
+  PtPressureWaitData data = {
+    .dir = dir,
+    .thresholds = thresholds,
+  };
+
+  g_return_val_if_fail (dir, TRUE);
+  g_return_val_if_fail (thresholds, TRUE);
+  g_return_val_if_fail (interval_ms > 0, TRUE);
+
+  if (check_settled (&data))
+    return TRUE;
+
+  context = g_main_context_new ();
+  loop = g_main_loop_new (context, FALSE);
+  data.loop = loop;
+
+  poll_source = g_timeout_source_new (interval_ms);
+  g_source_set_callback (poll_source, on_poll_timeout, &data, NULL);
+  g_source_attach (poll_source, context);
+
+  max_wait_source = g_timeout_source_new (max_wait_ms);
+  g_source_set_callback (max_wait_source, on_max_wait_timeout, &data, NULL);
+  g_source_attach (max_wait_source, context);
+
+  g_main_context_push_thread_default (context);
+  g_main_loop_run (loop);
+  g_main_context_pop_thread_default (context);
+
+  g_source_destroy (poll_source);
+  g_source_destroy (max_wait_source);
+
+  return data.settled;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * PtPressure:
+ * @cpu: The share of time some tasks stalled on CPU in percent
+ * @io: The share of time some tasks stalled on IO in percent
+ * @memory: The share of time some tasks stalled on memory in percent
+ *
+ * Pressure stall information averaged over the last 10 seconds.
+ */
+typedef struct {
+  double cpu;
+  double io;
+  double memory;
+} PtPressure;
+
+const char *pt_pressure_get_default_dir (void);
+gboolean    pt_pressure_read            (const char       *dir,
+                                         PtPressure       *pressure,
+                                         GError          **err);
+gboolean    pt_pressure_exceeds         (const PtPressure *pressure,
+                                         const PtPressure *thresholds);
+gboolean    pt_pressure_wait            (const char       *dir,
+                                         const PtPressure *thresholds,
+                                         guint             interval_ms,
+                                         guint             max_wait_ms);
+
+G_END_DECLS
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-scaled-texture"
+
+#include "phosh-tour-config.h"
+
+#include "pt-scaled-texture.h"
+
+/**
+ * PtScaledTexture:
+ *
+ * A paintable wrapping a texture that was rendered for a given scale
+ * factor. The intrinsic size is reported in logical pixels so that
+ * e.g. a texture rendered at 2x takes up the same space as the 1x one.
+ */
+
+struct _PtScaledTexture {
+  GObject     parent;
+
+  GdkTexture *texture;
+  int         scale;
+};
+
+static void pt_scaled_texture_paintable_iface_init (GdkPaintableInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (PtScaledTexture, pt_scaled_texture, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (GDK_TYPE_PAINTABLE,
+                                                pt_scaled_texture_paintable_iface_init))
+
+
+static void
+pt_scaled_texture_snapshot (GdkPaintable *paintable,
+                            GdkSnapshot  *snapshot,
+                            double        width,
+                            double        height)
+{
+  PtScaledTexture *self = PT_SCALED_TEXTURE (paintable);
+
+  gdk_paintable_snapshot (GDK_PAINTABLE (self->texture), snapshot, width, height);
+}
+
+
+static int
+pt_scaled_texture_get_intrinsic_width (GdkPaintable *paintable)
+{
+  PtScaledTexture *self = PT_SCALED_TEXTURE (paintable);
+
+  return gdk_texture_get_width (self->texture) / self->scale;
+}
+
+
+static int
+pt_scaled_texture_get_intrinsic_height (GdkPaintable *paintable)
+{
+  PtScaledTexture *self = PT_SCALED_TEXTURE (paintable);
+
+  return gdk_texture_get_height (self->texture) / self->scale;
+}
+
+
+static GdkPaintableFlags
+pt_scaled_texture_get_flags (GdkPaintable *paintable)
+{
+  return GDK_PAINTABLE_STATIC_SIZE | GDK_PAINTABLE_STATIC_CONTENTS;
+}
+
+
+static void
+pt_scaled_texture_paintable_iface_init (GdkPaintableInterface *iface)
+{
+  iface->snapshot = pt_scaled_texture_snapshot;
+  iface->get_intrinsic_width = pt_scaled_texture_get_intrinsic_width;
+  iface->get_intrinsic_height = pt_scaled_texture_get_intrinsic_height;
+  iface->get_flags = pt_scaled_texture_get_flags;
+}
+
+
+static void
+pt_scaled_texture_finalize (GObject *object)
+{
+  PtScaledTexture *self = PT_SCALED_TEXTURE (object);
+
+  g_clear_object (&self->texture);
+
+  G_OBJECT_CLASS (pt_scaled_texture_parent_class)->finalize (object);
+}
+
+
+static void
+pt_scaled_texture_class_init (PtScaledTextureClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = pt_scaled_texture_finalize;
+}
+
+
+static void
+pt_scaled_texture_init (PtScaledTexture *self)
+{
+  self->scale = 1;
+}
+
+
+PtScaledTexture *
+pt_scaled_texture_new (GdkTexture *texture, int scale)
+{
+  PtScaledTexture *self;
+
+  g_return_val_if_fail (GDK_IS_TEXTURE (texture), NULL);
+  g_return_val_if_fail (scale > 0, NULL);
+
+  self = g_object_new (PT_TYPE_SCALED_TEXTURE, NULL);
+  self->texture = g_object_ref (texture);
+  self->scale = scale;
+
+  return self;
+}
+
+
+GdkTexture *
+pt_scaled_texture_get_texture (PtScaledTexture *self)
+{
+  g_return_val_if_fail (PT_IS_SCALED_TEXTURE (self), NULL);
+
+  return self->texture;
+}
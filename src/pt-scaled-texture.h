@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define PT_TYPE_SCALED_TEXTURE (pt_scaled_texture_get_type ())
+
+G_DECLARE_FINAL_TYPE (PtScaledTexture, pt_scaled_texture, PT, SCALED_TEXTURE, GObject)
+
+PtScaledTexture *pt_scaled_texture_new         (GdkTexture *texture, int scale);
+GdkTexture      *pt_scaled_texture_get_texture (PtScaledTexture *self);
+
+G_END_DECLS
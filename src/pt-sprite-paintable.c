@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-sprite-paintable"
+
+#include "phosh-tour-config.h"
+
+#include "pt-sprite-paintable.h"
+
+/**
+ * PtSpritePaintable:
+ *
+ * A paintable playing back an animated illustration from a sprite
+ * sheet pre-rendered at build time (see build-aux/pt-compose-sprites.py).
+ * Only a horizontal band of the illustration is animated: the sheet
+ * holds that band's frames stacked vertically, everything else comes
+ * from the static base image.
+ *
+ * Playback is driven by the frame clock of the widget showing the
+ * paintable. Advancing a frame only moves the sheet within the band so
+ * the sheet is uploaded once and nothing gets rendered on the CPU.
+ * When stopped the paintable shows the base image and no tick
+ * callback is installed.
+ */
+
+struct _PtSpritePaintable {
+  GObject       parent;
+
+  GdkPaintable *base;
+  GdkTexture   *sheet;
+  guint         frames;
+  /* The band in pixels of the base's intrinsic size */
+  int           top;
+  int           height;
+  gint64        duration;
+
+  GtkWidget    *widget;
+  guint         tick_id;
+  gint64        start;
+  guint         frame;
+};
+
+static void pt_sprite_paintable_paintable_iface_init (GdkPaintableInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (PtSpritePaintable, pt_sprite_paintable, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (GDK_TYPE_PAINTABLE,
+                                                pt_sprite_paintable_paintable_iface_init))
+
+
+static void
+pt_sprite_paintable_snapshot (GdkPaintable *paintable,
+                              GdkSnapshot  *snapshot,
+                              double        width,
+                              double        height)
+{
+  PtSpritePaintable *self = PT_SPRITE_PAINTABLE (paintable);
+  int base_height = gdk_paintable_get_intrinsic_height (self->base);
+  double band_top, band_height, scale;
+
+  if (self->tick_id == 0 || base_height <= 0) {
+    gdk_paintable_snapshot (self->base, snapshot, width, height);
+    return;
+  }
+
+  scale = height / base_height;
+  band_top = self->top * scale;
+  band_height = self->height * scale;
+
+  /* The static parts above and below the band */
+  gtk_snapshot_push_clip (GTK_SNAPSHOT (snapshot), &GRAPHENE_RECT_INIT (0, 0, width, band_top));
+  gdk_paintable_snapshot (self->base, snapshot, width, height);
+  gtk_snapshot_pop (GTK_SNAPSHOT (snapshot));
+
+  gtk_snapshot_push_clip (GTK_SNAPSHOT (snapshot),
+                          &GRAPHENE_RECT_INIT (0, band_top + band_height,
+                                               width, height - band_top - band_height));
+  gdk_paintable_snapshot (self->base, snapshot, width, height);
+  gtk_snapshot_pop (GTK_SNAPSHOT (snapshot));
+
+  /* The current frame */
+  gtk_snapshot_push_clip (GTK_SNAPSHOT (snapshot),
+                          &GRAPHENE_RECT_INIT (0, band_top, width, band_height));
+  gtk_snapshot_append_texture (GTK_SNAPSHOT (snapshot),
+                               self->sheet,
+                               &GRAPHENE_RECT_INIT (0, band_top - self->frame * band_height,
+                                                    width, band_height * self->frames));
+  gtk_snapshot_pop (GTK_SNAPSHOT (snapshot));
+}
+
+
+static int
+pt_sprite_paintable_get_intrinsic_width (GdkPaintable *paintable)
+{
+  PtSpritePaintable *self = PT_SPRITE_PAINTABLE (paintable);
+
+  return gdk_paintable_get_intrinsic_width (self->base);
+}
+
+
+static int
+pt_sprite_paintable_get_intrinsic_height (GdkPaintable *paintable)
+{
+  PtSpritePaintable *self = PT_SPRITE_PAINTABLE (paintable);
+
+  return gdk_paintable_get_intrinsic_height (self->base);
+}
+
+
+static GdkPaintableFlags
+pt_sprite_paintable_get_flags (GdkPaintable *paintable)
+{
+  return GDK_PAINTABLE_STATIC_SIZE;
+}
+
+
+static void
+pt_sprite_paintable_paintable_iface_init (GdkPaintableInterface *iface)
+{
+  iface->snapshot = pt_sprite_paintable_snapshot;
+  iface->get_intrinsic_width = pt_sprite_paintable_get_intrinsic_width;
+  iface->get_intrinsic_height = pt_sprite_paintable_get_intrinsic_height;
+  iface->get_flags = pt_sprite_paintable_get_flags;
+}
+
+
+static gboolean
+on_tick (GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data)
+{
+  PtSpritePaintable *self = PT_SPRITE_PAINTABLE (user_data);
+  gint64 now = gdk_frame_clock_get_frame_time (frame_clock);
+  guint frame;
+
+  if (self->start == 0)
+    self->start = now;
+
+  frame = ((now - self->start) * self->frames / self->duration) % self->frames;
+  if (frame != self->frame) {
+    self->frame = frame;
+    gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+
+static void
+on_widget_finalized (gpointer data, GObject *where_the_object_was)
+{
+  PtSpritePaintable *self = PT_SPRITE_PAINTABLE (data);
+
+  /* The tick callback is gone with the widget */
+  self->widget = NULL;
+  self->tick_id = 0;
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+}
+
+
+static void
+pt_sprite_paintable_dispose (GObject *object)
+{
+  PtSpritePaintable *self = PT_SPRITE_PAINTABLE (object);
+
+  pt_sprite_paintable_stop (self);
+
+  G_OBJECT_CLASS (pt_sprite_paintable_parent_class)->dispose (object);
+}
+
+
+static void
+pt_sprite_paintable_finalize (GObject *object)
+{
+  PtSpritePaintable *self = PT_SPRITE_PAINTABLE (object);
+
+  g_clear_object (&self->base);
+  g_clear_object (&self->sheet);
+
+  G_OBJECT_CLASS (pt_sprite_paintable_parent_class)->finalize (object);
+}
+
+
+static void
+pt_sprite_paintable_class_init (PtSpritePaintableClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = pt_sprite_paintable_dispose;
+  object_class->finalize = pt_sprite_paintable_finalize;
+}
+
+
+static void
+pt_sprite_paintable_init (PtSpritePaintable *self)
+{
+}
+
+/**
+ * pt_sprite_paintable_new:
+ * @base: The static image
+ * @sheet: The sprite sheet with the band's frames stacked vertically
+ * @frames: The number of frames
+ * @top: The top of the animated band in the base's intrinsic size
+ * @height: The height of the animated band in the base's intrinsic size
+ * @duration_ms: The duration of one loop in milliseconds
+ *
+ * Returns: The new paintable
+ */
+PtSpritePaintable *
+pt_sprite_paintable_new (GdkPaintable *base,
+                         GdkTexture   *sheet,
+                         guint         frames,
+                         int           top,
+                         int           height,
+                         guint         duration_ms)
+{
+  PtSpritePaintable *self;
+
+  g_return_val_if_fail (GDK_IS_PAINTABLE (base), NULL);
+  g_return_val_if_fail (GDK_IS_TEXTURE (sheet), NULL);
+  g_return_val_if_fail (frames > 0, NULL);
+  g_return_val_if_fail (height > 0, NULL);
+  g_return_val_if_fail (duration_ms > 0, NULL);
+
+  self = g_object_new (PT_TYPE_SPRITE_PAINTABLE, NULL);
+  self->base = g_object_ref (base);
+  self->sheet = g_object_ref (sheet);
+  self->frames = frames;
+  self->top = top;
+  self->height = height;
+  self->duration = (gint64) duration_ms * 1000;
+
+  return self;
+}
+
+
+GdkPaintable *
+pt_sprite_paintable_get_base (PtSpritePaintable *self)
+{
+  g_return_val_if_fail (PT_IS_SPRITE_PAINTABLE (self), NULL);
+
+  return self->base;
+}
+
+
+GdkTexture *
+pt_sprite_paintable_get_sheet (PtSpritePaintable *self)
+{
+  g_return_val_if_fail (PT_IS_SPRITE_PAINTABLE (self), NULL);
+
+  return self->sheet;
+}
+
+/**
+ * pt_sprite_paintable_play:
+ * @self: The sprite paintable
+ * @widget: The widget showing the paintable
+ *
+ * Starts playback from the first frame driven by @widget's frame
+ * clock. Playback stops when @widget goes away.
+ */
+void
+pt_sprite_paintable_play (PtSpritePaintable *self, GtkWidget *widget)
+{
+  g_return_if_fail (PT_IS_SPRITE_PAINTABLE (self));
+  g_return_if_fail (GTK_IS_WIDGET (widget));
+
+  if (self->tick_id && self->widget == widget)
+    return;
+
+  pt_sprite_paintable_stop (self);
+
+  self->widget = widget;
+  g_object_weak_ref (G_OBJECT (self->widget), on_widget_finalized, self);
+  self->start = 0;
+  self->frame = 0;
+  self->tick_id = gtk_widget_add_tick_callback (widget, on_tick, self, NULL);
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+}
+
+/**
+ * pt_sprite_paintable_stop:
+ * @self: The sprite paintable
+ *
+ * Stops playback and shows the static base image again.
+ */
+void
+pt_sprite_paintable_stop (PtSpritePaintable *self)
+{
+  g_return_if_fail (PT_IS_SPRITE_PAINTABLE (self));
+
+  if (self->tick_id == 0)
+    return;
+
+  gtk_widget_remove_tick_callback (self->widget, self->tick_id);
+  g_object_weak_unref (G_OBJECT (self->widget), on_widget_finalized, self);
+  self->widget = NULL;
+  self->tick_id = 0;
+  gdk_paintable_invalidate_contents (GDK_PAINTABLE (self));
+}
+
+
+gboolean
+pt_sprite_paintable_is_playing (PtSpritePaintable *self)
+{
+  g_return_val_if_fail (PT_IS_SPRITE_PAINTABLE (self), FALSE);
+
+  return self->tick_id != 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+#define PT_TYPE_SPRITE_PAINTABLE (pt_sprite_paintable_get_type ())
+
+G_DECLARE_FINAL_TYPE (PtSpritePaintable, pt_sprite_paintable, PT, SPRITE_PAINTABLE, GObject)
+
+PtSpritePaintable *pt_sprite_paintable_new        (GdkPaintable      *base,
+                                                   GdkTexture        *sheet,
+                                                   guint              frames,
+                                                   int                top,
+                                                   int                height,
+                                                   guint              duration_ms);
+GdkPaintable      *pt_sprite_paintable_get_base   (PtSpritePaintable *self);
+GdkTexture        *pt_sprite_paintable_get_sheet  (PtSpritePaintable *self);
+void               pt_sprite_paintable_play       (PtSpritePaintable *self,
+                                                   GtkWidget         *widget);
+void               pt_sprite_paintable_stop       (PtSpritePaintable *self);
+gboolean           pt_sprite_paintable_is_playing (PtSpritePaintable *self);
+
+G_END_DECLS
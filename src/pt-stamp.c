@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-stamp"
+
+#include "phosh-tour-config.h"
+
+#include "pt-stamp.h"
+
+#include <errno.h>
+
+/*
+ * The run-once stamp records the tour version and the ids of the pages
+ * the user has seen so later runs can show only what's new:
+ *
+ *   [Tour]
+ *   Version=0.50.0
+ *   Pages=welcome;go-home;...
+ *
+ * Stamps written before pages had ids are empty files. These count as
+ * having seen the pages the tour had back then.
+ */
+
+#define PT_STAMP_GROUP "Tour"
+
+static const char *const legacy_page_ids[] = {
+  "welcome",
+  "kill-switches",
+  "go-home",
+  "show-keyboard",
+  "quick-settings",
+  "power-menu",
+  "slide-to-unlock",
+  "close-apps",
+  "launch-apps",
+  "see-notifications",
+  "all-set",
+  NULL
+};
+
+
+char *
+pt_stamp_get_path (void)
+{
+  return g_build_filename (g_get_user_config_dir (), "phosh-tour", "run-once", NULL);
+}
+
+/**
+ * pt_stamp_load:
+ * @path: The stamp's path
+ * @version:(out)(nullable): The version of the tour that wrote the stamp
+ * @page_ids:(out): The ids of the pages the user has seen
+ * @error: Return location for an error
+ *
+ * Loads the run-once stamp at @path.
+ *
+ * Returns: %TRUE on success
+ */
+gboolean
+pt_stamp_load (const char *path, char **version, GStrv *page_ids, GError **error)
+{
+  g_autoptr (GKeyFile) keyfile = g_key_file_new ();
+  g_autofree char *contents = NULL;
+  gsize len;
+
+  g_return_val_if_fail (path != NULL, FALSE);
+  g_return_val_if_fail (version != NULL, FALSE);
+  g_return_val_if_fail (page_ids != NULL, FALSE);
+
+  if (!g_file_get_contents (path, &contents, &len, error))
+    return FALSE;
+
+  if (len == 0) {
+    *version = NULL;
+    *page_ids = g_strdupv ((GStrv) legacy_page_ids);
+    return TRUE;
+  }
+
+  if (!g_key_file_load_from_data (keyfile, contents, len, G_KEY_FILE_NONE, error))
+    return FALSE;
+
+  *version = g_key_file_get_string (keyfile, PT_STAMP_GROUP, "Version", NULL);
+  *page_ids = g_key_file_get_string_list (keyfile, PT_STAMP_GROUP, "Pages", NULL, NULL);
+  if (*page_ids == NULL)
+    *page_ids = g_new0 (char *, 1);
+
+  return TRUE;
+}
+
+/**
+ * pt_stamp_save:
+ * @path: The stamp's path
+ * @version: The tour's version
+ * @page_ids: The ids of the pages the user has seen
+ * @error: Return location for an error
+ *
+ * Saves the run-once stamp to @path creating parent directories as
+ * needed.
+ *
+ * Returns: %TRUE on success
+ */
+gboolean
+pt_stamp_save (const char *path, const char *version, const char *const *page_ids, GError **error)
+{
+  g_autoptr (GKeyFile) keyfile = g_key_file_new ();
+  g_autofree char *dir = g_path_get_dirname (path);
+  g_autofree char *contents = NULL;
+  gsize len;
+
+  g_return_val_if_fail (path != NULL, FALSE);
+  g_return_val_if_fail (version != NULL, FALSE);
+  g_return_val_if_fail (page_ids != NULL, FALSE);
+
+  if (g_mkdir_with_parents (dir, 0755) != 0) {
+    int saved_errno = errno;
+
+    g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (saved_errno),
+                 "Failed to create %s: %s", dir, g_strerror (saved_errno));
+    return FALSE;
+  }
+
+  g_key_file_set_string (keyfile, PT_STAMP_GROUP, "Version", version);
+  g_key_file_set_string_list (keyfile, PT_STAMP_GROUP, "Pages",
+                              page_ids, g_strv_length ((GStrv) page_ids));
+  contents = g_key_file_to_data (keyfile, &len, NULL);
+
+  /* Write atomically so a crash never leaves a partial or missing stamp behind */
+  return g_file_set_contents_full (path, contents, len,
+                                   G_FILE_SET_CONTENTS_CONSISTENT | G_FILE_SET_CONTENTS_DURABLE,
+                                   0644, error);
+}
+
+/**
+ * pt_stamp_get_unseen_pages:
+ * @seen_page_ids: The ids of the pages the user has seen
+ * @page_ids: The ids of the current pages
+ *
+ * Gets the ids in @page_ids that aren't in @seen_page_ids.
+ *
+ * Returns:(transfer full): The unseen pages' ids
+ */
+GStrv
+pt_stamp_get_unseen_pages (const char *const *seen_page_ids, const char *const *page_ids)
+{
+  g_autoptr (GStrvBuilder) builder = g_strv_builder_new ();
+
+  for (int i = 0; page_ids[i]; i++) {
+    if (!g_strv_contains (seen_page_ids, page_ids[i]))
+      g_strv_builder_add (builder, page_ids[i]);
+  }
+
+  return g_strv_builder_end (builder);
+}
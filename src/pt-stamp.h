@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+char     *pt_stamp_get_path         (void);
+gboolean  pt_stamp_load             (const char  *path,
+                                     char       **version,
+                                     GStrv       *page_ids,
+                                     GError     **error);
+gboolean  pt_stamp_save             (const char         *path,
+                                     const char         *version,
+                                     const char *const  *page_ids,
+                                     GError            **error);
+GStrv     pt_stamp_get_unseen_pages (const char *const *seen_page_ids,
+                                     const char *const *page_ids);
+
+G_END_DECLS
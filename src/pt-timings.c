@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-timings"
+
+#include "phosh-tour-config.h"
+
+#include "pt-timings.h"
+#include "pt-util.h"
+
+typedef struct {
+  char   *name;
+  gint64  time;
+} PtTimingsMark;
+
+static gint64  start_time;
+static char   *output;
+static GArray *marks;
+
+
+static void
+pt_timings_mark_clear (gpointer data)
+{
+  PtTimingsMark *mark = data;
+
+  g_free (mark->name);
+}
+
+
+/**
+ * pt_timings_init:
+ *
+ * Initializes startup timings. These record timestamps of interesting
+ * points relative to `main()` so startup regressions can be tracked.
+ * Recording is enabled via the `PHOSH_TOUR_TIMINGS` environment
+ * variable (a file name or `-` for stdout) or `--benchmark`. The
+ * result is written as JSON by [func@timings_dump].
+ */
+void
+pt_timings_init (void)
+{
+  const char *env = g_getenv ("PHOSH_TOUR_TIMINGS");
+
+  start_time = g_get_monotonic_time ();
+
+  if (env && env[0] != '\0')
+    pt_timings_enable (env);
+}
+
+
+void
+pt_timings_enable (const char *out)
+{
+  g_return_if_fail (out != NULL);
+
+  g_free (output);
+  output = g_strdup (out);
+
+  if (marks)
+    return;
+
+  marks = g_array_new (FALSE, FALSE, sizeof (PtTimingsMark));
+  g_array_set_clear_func (marks, pt_timings_mark_clear);
+}
+
+
+gboolean
+pt_timings_is_enabled (void)
+{
+  return !!marks;
+}
+
+
+void
+pt_timings_mark (const char *format, ...)
+{
+  PtTimingsMark mark;
+  va_list args;
+
+  if (!marks)
+    return;
+
+  mark.time = g_get_monotonic_time () - start_time;
+  va_start (args, format);
+  mark.name = g_strdup_vprintf (format, args);
+  va_end (args);
+
+  g_array_append_val (marks, mark);
+}
+
+
+/**
+ * pt_timings_has_mark:
+ * @name: The mark's name
+ *
+ * Returns: Whether a mark with the given name was recorded
+ */
+gboolean
+pt_timings_has_mark (const char *name)
+{
+  g_return_val_if_fail (name != NULL, FALSE);
+
+  if (!marks)
+    return FALSE;
+
+  for (guint i = 0; i < marks->len; i++) {
+    if (g_str_equal (g_array_index (marks, PtTimingsMark, i).name, name))
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+
+void
+pt_timings_dump (void)
+{
+  g_autoptr (GString) json = NULL;
+  g_autoptr (GError) err = NULL;
+
+  if (!marks)
+    return;
+
+  json = g_string_new ("{\n  \"version\": ");
+  pt_util_append_json_string (json, PHOSH_TOUR_VERSION);
+  g_string_append (json, ",\n  \"gsk-renderer\": ");
+  pt_util_append_json_string (json, g_getenv ("GSK_RENDERER") ?: "");
+  g_string_append (json, ",\n  \"marks\": [");
+
+  /* main() is the implicit zero point */
+  g_string_append (json, "\n    { \"name\": \"main\", \"usec\": 0 }");
+  for (guint i = 0; i < marks->len; i++) {
+    PtTimingsMark *mark = &g_array_index (marks, PtTimingsMark, i);
+
+    g_string_append (json, ",\n    { \"name\": ");
+    pt_util_append_json_string (json, mark->name);
+    g_string_append_printf (json, ", \"usec\": %" G_GINT64_FORMAT " }", mark->time);
+  }
+  g_string_append (json, "\n  ]\n}\n");
+
+  if (!pt_util_write_output (output, json->str, &err))
+    g_warning ("Failed to write timings to %s: %s", output, err->message);
+
+  g_clear_pointer (&marks, g_array_unref);
+  g_clear_pointer (&output, g_free);
+}
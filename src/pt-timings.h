@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+void     pt_timings_init       (void);
+void     pt_timings_enable     (const char *out);
+gboolean pt_timings_is_enabled (void);
+void     pt_timings_mark       (const char *format, ...) G_GNUC_PRINTF (1, 2);
+gboolean pt_timings_has_mark   (const char *name);
+void     pt_timings_dump       (void);
+
+G_END_DECLS
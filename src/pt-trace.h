@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "phosh-tour-config.h"
+
+#include <glib.h>
+
+/*
+ * Marks for sysprof so the tour's startup and navigation can be
+ * correlated with the rest of the session in one capture. Spans are
+ * recorded like
+ *
+ *   gint64 begin G_GNUC_UNUSED = PT_TRACE_NOW ();
+ *   …
+ *   PT_TRACE_MARK (begin, "page-materialize", "%s", summary);
+ *
+ * Without the `sysprof` build option this compiles to nothing.
+ */
+
+#if PT_HAVE_SYSPROF
+
+#include <sysprof-capture.h>
+
+#define PT_TRACE_INIT() sysprof_clock_init ()
+#define PT_TRACE_NOW() SYSPROF_CAPTURE_CURRENT_TIME
+#define PT_TRACE_MARK(begin, name, ...)                                  \
+  sysprof_collector_mark_printf ((begin),                                \
+                                 SYSPROF_CAPTURE_CURRENT_TIME - (begin), \
+                                 "phosh-tour",                           \
+                                 (name),                                 \
+                                 __VA_ARGS__)
+
+#else
+
+#define PT_TRACE_INIT() G_STMT_START { } G_STMT_END
+#define PT_TRACE_NOW() ((gint64) 0)
+#define PT_TRACE_MARK(begin, name, ...) G_STMT_START { } G_STMT_END
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "pt-util"
+
+#include "phosh-tour-config.h"
+
+#include "pt-util.h"
+
+#include <string.h>
+
+/**
+ * pt_util_append_json_string:
+ * @str: The string to append to
+ * @value: The value to append
+ *
+ * Appends @value as a quoted and escaped JSON string.
+ */
+void
+pt_util_append_json_string (GString *str, const char *value)
+{
+  g_string_append_c (str, '"');
+  for (const char *c = value; *c; c++) {
+    if (*c == '"' || *c == '\\')
+      g_string_append_printf (str, "\\%c", *c);
+    else if ((guchar)*c < 0x20)
+      g_string_append_printf (str, "\\u%04x", (guchar)*c);
+    else
+      g_string_append_c (str, *c);
+  }
+  g_string_append_c (str, '"');
+}
+
+/**
+ * pt_util_write_output:
+ * @output: A file name or `-` for stdout
+ * @contents: The contents to write
+ * @err: The return location for errors
+ *
+ * Writes statistics like timings to the given output.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ */
+gboolean
+pt_util_write_output (const char *output, const char *contents, GError **err)
+{
+  if (g_strcmp0 (output, "-") == 0) {
+    g_print ("%s", contents);
+    return TRUE;
+  }
+
+  return g_file_set_contents (output, contents, strlen (contents), err);
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+void     pt_util_append_json_string (GString *str, const char *value);
+gboolean pt_util_write_output       (const char *output, const char *contents, GError **err);
+
+G_END_DECLS
@@ -11,26 +11,277 @@
 
 #include "phosh-tour-config.h"
 #include "pt-application.h"
+#include "pt-device.h"
+#include "pt-frame-stats.h"
+#include "pt-image-loader.h"
+#include "pt-low-power.h"
+#include "pt-memory.h"
 #include "pt-hw-page.h"
 #include "pt-window.h"
 #include "pt-page.h"
+#include "pt-page-manifest.h"
+#include "pt-page-packs.h"
+#include "pt-prefetcher.h"
+#include "pt-timings.h"
+#include "pt-trace.h"
 
-#define GMOBILE_USE_UNSTABLE_API
-#include <gmobile.h>
 #include <glib/gi18n.h>
 
+#include <float.h>
+
+
+/**
+ * PtWindow:
+ *
+ * The main window holding the tour's pages. With `lazy-pages` enabled
+ * only the current page and its neighbours are materialized, all other
+ * pages stay placeholders until the user navigates towards them.
+ *
+ * Decoded page images are kept within the `image-budget`: once it's
+ * exceeded the least recently shown images of pages that aren't
+ * adjacent to the current one are released. If available memory is
+ * below `text-only-threshold` at startup no images are shown at all.
+ *
+ * In lazy mode a [class@Prefetcher] additionally warms the pages the
+ * user is heading to.
+ *
+ * Pages come from the compiled page manifest and the drop-in page
+ * packs merged on top of it. If `seen-pages` is set only pages the
+ * user hasn't seen yet are shown.
+ *
+ * In low power mode pages switch without animation, swipes settle
+ * right away and nothing is prefetched so the frame clock stays idle
+ * between interactions.
+ *
+ * Animated illustrations only play on the settled current page and
+ * are paused during transitions and in low power mode. During
+ * transitions pages replay their cached rendering.
+ *
+ * The tour can start at or jump to any page by its id. Such jumps
+ * don't animate so only the target page and its neighbours get built.
+ */
+
+/* Critically damped and stiff enough to settle within a few frames */
+#define LOW_POWER_SCROLL_STIFFNESS 20000.0
+
+enum {
+  PROP_0,
+  PROP_SEEN_PAGES,
+  PROP_LOW_POWER,
+  PROP_INITIAL_PAGE,
+  PROP_LAST_PROP
+};
+static GParamSpec *props[PROP_LAST_PROP];
 
 struct _PtWindow {
   AdwApplicationWindow parent_instance;
 
+  GSettings           *settings;
   AdwCarousel         *main_carousel;
+  gboolean             lazy_pages;
+  int                  current;
+  /* The page playing its animation, -1 if none */
+  int                  playing;
+  gboolean             in_transition;
+
+  GPtrArray           *pages;
+  GStrv                seen_pages;
+  char                *initial_page;
+  /* The page to show once mapped, -1 if none */
+  int                  pending_page;
+  /* Materialized pages, most recently shown first */
+  GQueue               lru;
+  gsize                image_budget;
+
+  PtPrefetcher        *prefetcher;
+  PtLowPower          *low_power;
+  gboolean             force_low_power;
+  AdwSpringParams     *scroll_params;
+
+  /* Start of the current goto_page () transition for tracing */
+  gint64               transition_begin;
+  int                  transition_from;
+  /* Target of the current goto_page () transition, -1 if none */
+  int                  transition_to;
 };
 
 G_DEFINE_TYPE (PtWindow, pt_window, ADW_TYPE_APPLICATION_WINDOW)
 
 
 static void
-goto_page (PtWindow *self, int num)
+touch_page (PtWindow *self, PtPage *page)
+{
+  GList *link = g_queue_find (&self->lru, page);
+
+  if (link)
+    g_queue_unlink (&self->lru, link);
+  else
+    link = g_list_alloc ();
+
+  link->data = page;
+  g_queue_push_head_link (&self->lru, link);
+}
+
+
+static void
+enforce_image_budget (PtWindow *self, int num)
+{
+  gsize total = 0;
+  GList *link;
+
+  if (self->image_budget == 0)
+    return;
+
+  for (link = self->lru.head; link; link = link->next)
+    total += pt_page_get_image_size (link->data);
+
+  link = self->lru.tail;
+  while (link && total > self->image_budget) {
+    PtPage *page = link->data;
+    gsize size;
+    guint pos;
+
+    link = link->prev;
+
+    if (!g_ptr_array_find (self->pages, page, &pos))
+      continue;
+
+    if (ABS ((int) pos - num) <= 1)
+      continue;
+
+    size = pt_page_get_image_size (page);
+    if (size == 0)
+      continue;
+
+    pt_page_unload_image (page);
+    total -= size;
+  }
+}
+
+
+static void
+materialize_around (PtWindow *self, int num)
+{
+  int n_pages = self->pages->len;
+
+  if (n_pages == 0)
+    return;
+
+  self->current = num;
+  for (int i = MAX (num - 1, 0); i <= MIN (num + 1, n_pages - 1); i++) {
+    PtPage *page = g_ptr_array_index (self->pages, i);
+
+    if (self->prefetcher)
+      pt_prefetcher_account (self->prefetcher, page);
+    pt_page_materialize (page);
+    pt_page_ensure_image (page);
+    if (i != num)
+      touch_page (self, page);
+  }
+  touch_page (self, g_ptr_array_index (self->pages, num));
+
+  enforce_image_budget (self, num);
+}
+
+
+static void
+set_playing_page (PtWindow *self, int num)
+{
+  if (pt_low_power_get_active (self->low_power))
+    num = -1;
+
+  if (self->playing == num)
+    return;
+
+  if (self->playing >= 0 && self->playing < (int) self->pages->len)
+    pt_page_set_playing (g_ptr_array_index (self->pages, self->playing), FALSE);
+
+  self->playing = num;
+  if (num >= 0 && num < (int) self->pages->len)
+    pt_page_set_playing (g_ptr_array_index (self->pages, num), TRUE);
+}
+
+
+static void
+set_in_transition (PtWindow *self, gboolean in_transition)
+{
+  if (self->in_transition == in_transition)
+    return;
+
+  self->in_transition = in_transition;
+  for (guint i = 0; i < self->pages->len; i++)
+    pt_page_set_cache_snapshot (g_ptr_array_index (self->pages, i), in_transition);
+
+  /* Don't animate pages in transition */
+  if (in_transition)
+    set_playing_page (self, -1);
+}
+
+
+static void
+on_position_changed (PtWindow *self)
+{
+  double position = adw_carousel_get_position (self->main_carousel);
+  int num = (int) (position + 0.5);
+  gboolean settled = G_APPROX_VALUE (position, (double) num, DBL_EPSILON);
+
+  /* Only record once the carousel moves. Transitions not started via
+   * goto_page () are swipes, a settled carousel has an integral position */
+  if (pt_frame_stats_is_enabled () && !pt_frame_stats_in_transition () && !settled) {
+    if (self->transition_to >= 0)
+      pt_frame_stats_begin (GTK_WIDGET (self), self->transition_from, self->transition_to);
+    else
+      pt_frame_stats_begin (GTK_WIDGET (self), self->current, -1);
+  }
+
+  set_in_transition (self, !settled);
+
+  /* Position changes on every frame while swiping */
+  if (num == self->current)
+    return;
+
+  materialize_around (self, num);
+}
+
+
+/* Images count against the budget only once they're decoded */
+static void
+on_page_image_loaded (PtWindow *self, PtPage *page)
+{
+  if (page == g_ptr_array_index (self->pages, self->current) &&
+      !pt_timings_has_mark ("first-image"))
+    pt_timings_mark ("first-image");
+
+  enforce_image_budget (self, self->current);
+}
+
+
+static void
+on_page_prefetched (PtWindow *self, PtPage *page)
+{
+  touch_page (self, page);
+  enforce_image_budget (self, self->current);
+}
+
+
+static void
+on_page_changed (PtWindow *self, guint index)
+{
+  pt_frame_stats_end (index);
+  self->transition_to = -1;
+  set_in_transition (self, FALSE);
+  set_playing_page (self, index);
+  pt_memory_sample (self->pages, "page-changed %u", index);
+
+  if (self->transition_begin) {
+    PT_TRACE_MARK (self->transition_begin, "goto-page", "%d → %u", self->transition_from, index);
+    self->transition_begin = 0;
+  }
+}
+
+
+static void
+goto_page (PtWindow *self, int num, gboolean animate)
 {
   int n_pages = adw_carousel_get_n_pages (self->main_carousel);
   GtkWidget *page;
@@ -41,8 +292,22 @@ goto_page (PtWindow *self, int num)
   if (num >= n_pages)
     return;
 
+  /* The carousel wouldn't move so nothing would end the transition */
+  if (num == self->current &&
+      G_APPROX_VALUE (adw_carousel_get_position (self->main_carousel), (double) num, DBL_EPSILON))
+    return;
+
+  self->transition_begin = PT_TRACE_NOW ();
+  self->transition_from = self->current;
+  self->transition_to = num;
+  /* A new recording starts once the carousel moves towards @num */
+  pt_frame_stats_end (-1);
+  set_in_transition (self, TRUE);
+  materialize_around (self, num);
+
   page = adw_carousel_get_nth_page (self->main_carousel, num);
-  adw_carousel_scroll_to (self->main_carousel, page, TRUE);
+  animate = animate && !pt_low_power_get_active (self->low_power);
+  adw_carousel_scroll_to (self->main_carousel, page, animate);
 }
 
 
@@ -54,7 +319,46 @@ on_flip_page_activated (GtkWidget *widget, const char *action_name, GVariant *pa
   gint32 offset;
 
   offset = g_variant_get_int32 (param);
-  goto_page (self, num + offset);
+  goto_page (self, num + offset, TRUE);
+}
+
+
+static int
+find_page (PtWindow *self, const char *page_id)
+{
+  for (guint i = 0; i < self->pages->len; i++) {
+    if (g_strcmp0 (pt_page_get_page_id (g_ptr_array_index (self->pages, i)), page_id) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
+
+static void
+on_goto_page_activated (GtkWidget *widget, const char *action_name, GVariant *param)
+{
+  PtWindow *self = PT_WINDOW (widget);
+  const char *page_id = g_variant_get_string (param, NULL);
+  int num;
+
+  num = find_page (self, page_id);
+  if (num < 0) {
+    g_warning ("No page '%s'", page_id);
+    return;
+  }
+
+  /* Jump right away, scrolling through would build the pages in between */
+  goto_page (self, num, FALSE);
+}
+
+
+static void
+on_memory_report_activated (GtkWidget *widget, const char *action_name, GVariant *param)
+{
+  PtWindow *self = PT_WINDOW (widget);
+
+  pt_memory_report (self->pages);
 }
 
 
@@ -78,11 +382,294 @@ get_btn_previous_visible (GObject *object, double position)
 }
 
 
+static void
+remove_seen_pages (PtWindow *self)
+{
+  guint n_seen = 0;
+
+  /* The final page always stays */
+  for (int i = (int) self->pages->len - 2; i >= 0; i--) {
+    PtPage *page = g_ptr_array_index (self->pages, i);
+
+    if (g_strv_contains ((const char *const *) self->seen_pages, pt_page_get_page_id (page))) {
+      g_ptr_array_remove_index (self->pages, i);
+      n_seen++;
+    }
+  }
+
+  g_debug ("Showing %u page(s), skipping %u seen page(s)", self->pages->len, n_seen);
+}
+
+
+static void
+on_low_power_changed (PtWindow *self)
+{
+  gboolean active = pt_low_power_get_active (self->low_power);
+  g_autoptr (AdwSpringParams) params = NULL;
+
+  /* Settle swipes within a few frames instead of a spring animation */
+  if (active)
+    params = adw_spring_params_new (1.0, 1.0, LOW_POWER_SCROLL_STIFFNESS);
+  else
+    params = adw_spring_params_ref (self->scroll_params);
+  adw_carousel_set_scroll_params (self->main_carousel, params);
+
+  if (self->prefetcher) {
+    pt_prefetcher_set_look_ahead (self->prefetcher,
+                                  active ? 0 : g_settings_get_uint (self->settings,
+                                                                    "prefetch-look-ahead"));
+  }
+
+  set_playing_page (self, active ? -1 : self->current);
+}
+
+
+static void
+pt_window_constructed (GObject *object)
+{
+  PtWindow *self = PT_WINDOW (object);
+  g_autoptr (GError) err = NULL;
+  gboolean show_images = TRUE;
+  guint threshold;
+  int initial = 0;
+
+  G_OBJECT_CLASS (pt_window_parent_class)->constructed (object);
+
+  threshold = g_settings_get_uint (self->settings, "text-only-threshold");
+  if (threshold) {
+    gint64 available = pt_device_get_mem_available ();
+
+    if (available >= 0 && available < (gint64) threshold * 1024) {
+      g_message ("Only %" G_GINT64_FORMAT " KiB of memory available, not showing images",
+                 available);
+      show_images = FALSE;
+    }
+  }
+
+  self->scroll_params = adw_spring_params_ref (adw_carousel_get_scroll_params (self->main_carousel));
+  self->low_power = pt_low_power_new (self->force_low_power, gtk_widget_get_settings (GTK_WIDGET (self)));
+  g_signal_connect_object (self->low_power,
+                           "notify::active",
+                           G_CALLBACK (on_low_power_changed),
+                           self,
+                           G_CONNECT_SWAPPED);
+
+  /* Incompatible hardware specific pages are already filtered out */
+  self->pages = pt_page_manifest_build_pages (&err);
+  if (self->pages == NULL) {
+    g_critical ("Failed to build pages: %s", err->message);
+    self->pages = g_ptr_array_new ();
+    return;
+  }
+  pt_page_packs_add_pages (self->pages);
+  /* Pages are only placeholders so far, dropping the seen ones is cheap */
+  if (self->seen_pages)
+    remove_seen_pages (self);
+
+  for (guint i = 0; i < self->pages->len; i++) {
+    PtPage *page = g_ptr_array_index (self->pages, i);
+
+    pt_page_set_show_image (page, show_images);
+    g_signal_connect_object (page,
+                             "image-loaded",
+                             G_CALLBACK (on_page_image_loaded),
+                             self,
+                             G_CONNECT_SWAPPED);
+    adw_carousel_append (self->main_carousel, GTK_WIDGET (page));
+  }
+  pt_timings_mark ("window-filter");
+  pt_memory_sample (self->pages, "window-filter");
+
+  if (self->lazy_pages) {
+    self->prefetcher = pt_prefetcher_new (self->main_carousel,
+                                          g_settings_get_uint (self->settings, "prefetch-look-ahead"));
+    g_signal_connect_object (self->prefetcher,
+                             "prefetched",
+                             G_CALLBACK (on_page_prefetched),
+                             self,
+                             G_CONNECT_SWAPPED);
+  } else {
+    for (guint i = 0; i < self->pages->len; i++)
+      pt_page_materialize (g_ptr_array_index (self->pages, i));
+  }
+
+  on_low_power_changed (self);
+
+  if (self->initial_page) {
+    initial = find_page (self, self->initial_page);
+    if (initial < 0) {
+      g_warning ("No page '%s', starting at the first one", self->initial_page);
+      initial = 0;
+    }
+  }
+  /* Only build what's shown first, the carousel moves there once mapped */
+  if (initial > 0)
+    self->pending_page = initial;
+
+  materialize_around (self, initial);
+  set_playing_page (self, initial);
+  g_signal_connect_object (self->main_carousel,
+                           "notify::position",
+                           G_CALLBACK (on_position_changed),
+                           self,
+                           G_CONNECT_SWAPPED);
+  g_signal_connect_object (self->main_carousel,
+                           "page-changed",
+                           G_CALLBACK (on_page_changed),
+                           self,
+                           G_CONNECT_SWAPPED);
+}
+
+
+static void
+pt_window_set_property (GObject      *object,
+                        guint         property_id,
+                        const GValue *value,
+                        GParamSpec   *pspec)
+{
+  PtWindow *self = PT_WINDOW (object);
+
+  switch (property_id) {
+  case PROP_SEEN_PAGES:
+    self->seen_pages = g_value_dup_boxed (value);
+    break;
+  case PROP_LOW_POWER:
+    self->force_low_power = g_value_get_boolean (value);
+    break;
+  case PROP_INITIAL_PAGE:
+    self->initial_page = g_value_dup_string (value);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_window_get_property (GObject    *object,
+                        guint       property_id,
+                        GValue     *value,
+                        GParamSpec *pspec)
+{
+  PtWindow *self = PT_WINDOW (object);
+
+  switch (property_id) {
+  case PROP_SEEN_PAGES:
+    g_value_set_boxed (value, self->seen_pages);
+    break;
+  case PROP_LOW_POWER:
+    g_value_set_boolean (value, self->force_low_power);
+    break;
+  case PROP_INITIAL_PAGE:
+    g_value_set_string (value, self->initial_page);
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+
+static void
+pt_window_dispose (GObject *object)
+{
+  PtWindow *self = PT_WINDOW (object);
+  PtImageLoaderStats stats;
+
+  g_clear_object (&self->prefetcher);
+  g_clear_object (&self->low_power);
+  g_clear_pointer (&self->scroll_params, adw_spring_params_unref);
+  g_clear_object (&self->settings);
+
+  pt_image_loader_get_cache_stats (&stats);
+  g_debug ("Image cache: %u hits, %u misses, %u evictions, %u entries, %" G_GSIZE_FORMAT " bytes",
+           stats.hits, stats.misses, stats.evictions, stats.entries, stats.size);
+
+  G_OBJECT_CLASS (pt_window_parent_class)->dispose (object);
+}
+
+
+static void
+pt_window_finalize (GObject *object)
+{
+  PtWindow *self = PT_WINDOW (object);
+
+  g_queue_clear (&self->lru);
+  g_clear_pointer (&self->pages, g_ptr_array_unref);
+  g_clear_pointer (&self->seen_pages, g_strfreev);
+  g_clear_pointer (&self->initial_page, g_free);
+
+  G_OBJECT_CLASS (pt_window_parent_class)->finalize (object);
+}
+
+
+static void
+pt_window_map (GtkWidget *widget)
+{
+  PtWindow *self = PT_WINDOW (widget);
+  GtkWidget *page;
+
+  GTK_WIDGET_CLASS (pt_window_parent_class)->map (widget);
+
+  if (self->pending_page < 0)
+    return;
+
+  page = adw_carousel_get_nth_page (self->main_carousel, self->pending_page);
+  self->pending_page = -1;
+  adw_carousel_scroll_to (self->main_carousel, page, FALSE);
+}
+
+
 static void
 pt_window_class_init (PtWindowClass *klass)
 {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
 
+  object_class->constructed = pt_window_constructed;
+  object_class->dispose = pt_window_dispose;
+  object_class->finalize = pt_window_finalize;
+  object_class->set_property = pt_window_set_property;
+  object_class->get_property = pt_window_get_property;
+
+  widget_class->map = pt_window_map;
+
+  /**
+   * PtWindow:seen-pages:
+   *
+   * The ids of the pages the user has already seen. If set only the
+   * other pages and the final page are shown.
+   */
+  props[PROP_SEEN_PAGES] =
+    g_param_spec_boxed ("seen-pages", "", "",
+                        G_TYPE_STRV,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * PtWindow:low-power:
+   *
+   * Whether to force low power mode. See [class@LowPower] for when
+   * it's enabled otherwise.
+   */
+  props[PROP_LOW_POWER] =
+    g_param_spec_boolean ("low-power", "", "",
+                          FALSE,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+  /**
+   * PtWindow:initial-page:
+   *
+   * The id of the page to start at. The pages before it aren't built
+   * unless the user navigates to them.
+   */
+  props[PROP_INITIAL_PAGE] =
+    g_param_spec_string ("initial-page", "", "",
+                         NULL,
+                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, PROP_LAST_PROP, props);
+
   g_type_ensure (PT_TYPE_PAGE);
   g_type_ensure (PT_TYPE_HW_PAGE);
 
@@ -94,33 +681,32 @@ pt_window_class_init (PtWindowClass *klass)
   gtk_widget_class_bind_template_callback (widget_class, get_btn_previous_visible);
 
   gtk_widget_class_install_action (widget_class, "win.flip-page", "i", on_flip_page_activated);
+  gtk_widget_class_install_action (widget_class, "win.goto-page", "s", on_goto_page_activated);
+  /* Debugging aid, see [func@memory_report] */
+  gtk_widget_class_install_action (widget_class, "win.memory-report", NULL,
+                                   on_memory_report_activated);
+  gtk_widget_class_add_binding_action (widget_class, GDK_KEY_m,
+                                       GDK_CONTROL_MASK | GDK_SHIFT_MASK,
+                                       "win.memory-report", NULL);
 }
 
 static void
 pt_window_init (PtWindow *self)
 {
-  g_auto (GStrv) compatibles = gm_device_tree_get_compatibles (NULL, NULL);
-  int kept = 0, removed = 0;
-
+  gint64 begin G_GNUC_UNUSED;
+
+  self->settings = g_settings_new (PHOSH_TOUR_APP_ID);
+  self->lazy_pages = g_settings_get_boolean (self->settings, "lazy-pages");
+  self->image_budget = (gsize) g_settings_get_uint (self->settings, "image-budget") * 1024 * 1024;
+  pt_image_loader_set_cache_size ((gsize) g_settings_get_uint (self->settings, "image-cache-size") * 1024 * 1024);
+  g_queue_init (&self->lru);
+  self->current = -1;
+  self->playing = -1;
+  self->pending_page = -1;
+  self->transition_to = -1;
+
+  begin = PT_TRACE_NOW ();
   gtk_widget_init_template (GTK_WIDGET (self));
-
-  while (kept < adw_carousel_get_n_pages (self->main_carousel)) {
-    GtkWidget *page;
-    gboolean compatible;
-
-    page = adw_carousel_get_nth_page (self->main_carousel, kept);
-
-    compatible = !PT_IS_HW_PAGE (page) ||
-      pt_hw_page_is_compatible (PT_HW_PAGE (page), (const char * const *)compatibles);
-
-    if (!compatible) {
-      adw_carousel_remove (self->main_carousel, page);
-      removed++;
-      continue;
-    }
-
-    kept++;
-  }
-
-  g_debug ("Kept %d page(s), removed %d hw specific page(s)", kept, removed);
+  PT_TRACE_MARK (begin, "window-template", "init template");
+  pt_timings_mark ("window-template");
 }
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-compatible-matcher.h"
+
+#include <string.h>
+
+/*
+ * Compare matching many synthetic pages' compatible patterns against
+ * a device's compatibles one page at a time (like PtHwPage used to)
+ * with the compiled matcher that evaluates all pages in one pass.
+ */
+
+#define ITERATIONS 50
+#define N_VENDORS  50
+
+
+static gboolean
+pattern_matches (const char *pattern, const char *compatible)
+{
+  gsize len = strlen (pattern);
+
+  if (len && pattern[len - 1] == '*')
+    return strncmp (pattern, compatible, len - 1) == 0;
+
+  return g_str_equal (pattern, compatible);
+}
+
+
+/* The nested scan, one page at a time */
+static gboolean
+naive_match (const char *const *patterns, const char *const *compatibles)
+{
+  gboolean has_positive = FALSE, has_negative = FALSE, positive = FALSE;
+
+  for (int i = 0; patterns[i]; i++) {
+    gboolean negated = patterns[i][0] == '!';
+    const char *pattern = negated ? &patterns[i][1] : patterns[i];
+
+    if (negated)
+      has_negative = TRUE;
+    else
+      has_positive = TRUE;
+
+    for (int j = 0; compatibles[j]; j++) {
+      if (!pattern_matches (pattern, compatibles[j]))
+        continue;
+
+      if (negated)
+        return FALSE;
+      positive = TRUE;
+    }
+  }
+
+  return has_positive ? positive : has_negative;
+}
+
+
+static void
+add_printf (GStrvBuilder *builder, const char *format, ...) G_GNUC_PRINTF (2, 3);
+
+static void
+add_printf (GStrvBuilder *builder, const char *format, ...)
+{
+  g_autofree char *str = NULL;
+  va_list args;
+
+  va_start (args, format);
+  str = g_strdup_vprintf (format, args);
+  va_end (args);
+
+  g_strv_builder_add (builder, str);
+}
+
+
+static GPtrArray *
+build_pages (guint n_pages)
+{
+  GPtrArray *pages = g_ptr_array_new_with_free_func ((GDestroyNotify) g_strfreev);
+
+  for (guint i = 0; i < n_pages; i++) {
+    g_autoptr (GStrvBuilder) builder = g_strv_builder_new ();
+
+    add_printf (builder, "vendor%u,board%u", i % N_VENDORS, i);
+    if (i % 3 == 0)
+      add_printf (builder, "vendor%u,*", (i * 7) % N_VENDORS);
+    if (i % 5 == 0)
+      add_printf (builder, "!vendor%u,board%u", i % N_VENDORS, i + 1);
+
+    g_ptr_array_add (pages, g_strv_builder_end (builder));
+  }
+
+  return pages;
+}
+
+
+static GStrv
+build_compatibles (guint n_compatibles)
+{
+  g_autoptr (GStrvBuilder) builder = g_strv_builder_new ();
+
+  for (guint i = 0; i < n_compatibles - 1; i++)
+    add_printf (builder, "vendor%u,board%u", i % N_VENDORS, i * 13);
+  g_strv_builder_add (builder, "generic-soc");
+
+  return g_strv_builder_end (builder);
+}
+
+
+static void
+bench (guint n_pages, guint n_compatibles, gboolean last)
+{
+  g_autoptr (GPtrArray) pages = build_pages (n_pages);
+  g_auto (GStrv) compatibles = build_compatibles (n_compatibles);
+  gint64 start, naive_usec = 0, matcher_usec = 0;
+  guint n_matches = 0;
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    g_autoptr (PtCompatibleMatcher) matcher = NULL;
+
+    start = g_get_monotonic_time ();
+    for (guint j = 0; j < pages->len; j++)
+      naive_match (g_ptr_array_index (pages, j), (const char *const *)compatibles);
+    naive_usec += g_get_monotonic_time () - start;
+
+    /* Includes compiling the patterns */
+    start = g_get_monotonic_time ();
+    matcher = pt_compatible_matcher_new ();
+    for (guint j = 0; j < pages->len; j++)
+      pt_compatible_matcher_add_rule (matcher, g_ptr_array_index (pages, j));
+    pt_compatible_matcher_match (matcher, (const char *const *)compatibles);
+    matcher_usec += g_get_monotonic_time () - start;
+
+    if (i > 0)
+      continue;
+
+    /* Both must agree */
+    for (guint j = 0; j < pages->len; j++) {
+      gboolean expected = naive_match (g_ptr_array_index (pages, j),
+                                       (const char *const *)compatibles);
+
+      g_assert_cmpint (pt_compatible_matcher_get_result (matcher, j), ==, expected);
+      n_matches += expected;
+    }
+  }
+
+  g_print ("    { \"pages\": %u, \"compatibles\": %u, \"matches\": %u, "
+           "\"naive-usec\": %" G_GINT64_FORMAT ", \"matcher-usec\": %" G_GINT64_FORMAT " }%s\n",
+           n_pages, n_compatibles, n_matches,
+           naive_usec / ITERATIONS, matcher_usec / ITERATIONS,
+           last ? "" : ",");
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  const guint sizes[][2] = {
+    { 10, 4 },
+    { 100, 4 },
+    { 100, 100 },
+    { 500, 200 },
+    { 1000, 500 },
+  };
+
+  g_print ("{\n  \"iterations\": %d,\n  \"runs\": [\n", ITERATIONS);
+  for (guint i = 0; i < G_N_ELEMENTS (sizes); i++)
+    bench (sizes[i][0], sizes[i][1], i == G_N_ELEMENTS (sizes) - 1);
+  g_print ("  ]\n}\n");
+
+  return 0;
+}
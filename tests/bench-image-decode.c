@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <gtk/gtk.h>
+
+#include <string.h>
+
+/*
+ * Compare decoding the page illustrations from their (minified) SVGs
+ * with decoding their build time rasters at each scale.
+ */
+
+#define PAGES_PATH "/mobi/phosh/PhoshTour/pages/"
+#define ITERATIONS 20
+#define MAX_SCALE  3
+
+
+/* Best of a few runs in µs, -1 if the resource doesn't exist */
+static gint64
+bench_decode (const char *path)
+{
+  g_autoptr (GBytes) bytes = NULL;
+  gint64 best = G_MAXINT64;
+
+  bytes = g_resources_lookup_data (path, G_RESOURCE_LOOKUP_FLAGS_NONE, NULL);
+  if (bytes == NULL)
+    return -1;
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    g_autoptr (GdkTexture) texture = NULL;
+    g_autoptr (GError) err = NULL;
+    gint64 start;
+
+    start = g_get_monotonic_time ();
+    texture = gdk_texture_new_from_bytes (bytes, &err);
+    if (texture == NULL)
+      g_error ("Failed to decode %s: %s", path, err->message);
+    best = MIN (best, g_get_monotonic_time () - start);
+  }
+
+  return best;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_auto (GStrv) children = NULL;
+  gboolean first = TRUE;
+
+  children = g_resources_enumerate_children (PAGES_PATH, G_RESOURCE_LOOKUP_FLAGS_NONE, NULL);
+  if (children == NULL)
+    g_error ("No page images in %s", PAGES_PATH);
+
+  g_print ("{\n  \"iterations\": %d,\n  \"images\": [", ITERATIONS);
+  for (int i = 0; children[i]; i++) {
+    g_autofree char *svg_path = NULL;
+    g_autofree char *name = NULL;
+
+    if (!g_str_has_suffix (children[i], ".svg"))
+      continue;
+
+    svg_path = g_strconcat (PAGES_PATH, children[i], NULL);
+    name = g_strndup (children[i], strlen (children[i]) - strlen (".svg"));
+
+    g_print ("%s\n    { \"name\": \"%s\", \"svg-usec\": %" G_GINT64_FORMAT,
+             first ? "" : ",", name, bench_decode (svg_path));
+    for (int scale = 1; scale <= MAX_SCALE; scale++) {
+      g_autofree char *raster_path = NULL;
+
+      raster_path = g_strdup_printf ("%sraster/%s@%dx.png", PAGES_PATH, name, scale);
+      g_print (", \"raster-%dx-usec\": %" G_GINT64_FORMAT, scale, bench_decode (raster_path));
+    }
+    g_print (" }");
+    first = FALSE;
+  }
+  g_print ("\n  ]\n}\n");
+
+  return 0;
+}
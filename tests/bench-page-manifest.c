@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-device.h"
+#include "pt-hw-page.h"
+#include "pt-page.h"
+#include "pt-page-manifest.h"
+
+#include <adwaita.h>
+
+/*
+ * Compare constructing the tour's pages by parsing their GtkBuilder
+ * definition with constructing them from the compiled manifest.
+ */
+
+#define ITERATIONS 200
+
+
+static gint64
+bench_builder (const char *ui)
+{
+  gint64 start, total = 0;
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    g_autoptr (GtkBuilder) builder = gtk_builder_new ();
+    g_autoptr (GError) err = NULL;
+    AdwCarousel *carousel;
+    int n = 0;
+
+    start = g_get_monotonic_time ();
+    if (!gtk_builder_add_from_string (builder, ui, -1, &err))
+      g_error ("Failed to parse pages: %s", err->message);
+
+    /* Filter like the window did */
+    carousel = ADW_CAROUSEL (gtk_builder_get_object (builder, "main_carousel"));
+    while (n < adw_carousel_get_n_pages (carousel)) {
+      GtkWidget *page = adw_carousel_get_nth_page (carousel, n);
+
+      if (PT_IS_HW_PAGE (page) &&
+          !pt_hw_page_is_compatible (PT_HW_PAGE (page), pt_device_get_compatibles ()))
+        adw_carousel_remove (carousel, page);
+      else
+        n++;
+    }
+    total += g_get_monotonic_time () - start;
+  }
+
+  return total / ITERATIONS;
+}
+
+
+static gint64
+bench_manifest (void)
+{
+  gint64 start, total = 0;
+
+  for (int i = 0; i < ITERATIONS; i++) {
+    g_autoptr (GPtrArray) pages = NULL;
+    g_autoptr (GError) err = NULL;
+    AdwCarousel *carousel = g_object_ref_sink (ADW_CAROUSEL (adw_carousel_new ()));
+
+    start = g_get_monotonic_time ();
+    pages = pt_page_manifest_build_pages (&err);
+    if (pages == NULL)
+      g_error ("Failed to build pages: %s", err->message);
+
+    for (guint j = 0; j < pages->len; j++)
+      adw_carousel_append (carousel, g_ptr_array_index (pages, j));
+    total += g_get_monotonic_time () - start;
+
+    g_object_unref (carousel);
+  }
+
+  return total / ITERATIONS;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_autofree char *ui = NULL;
+  g_autoptr (GError) err = NULL;
+  gint64 builder_usec, manifest_usec;
+
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_type_ensure (PT_TYPE_PAGE);
+  g_type_ensure (PT_TYPE_HW_PAGE);
+
+  if (!g_file_get_contents (PT_PAGES_BUILDER_UI, &ui, NULL, &err))
+    g_error ("Failed to read %s: %s", PT_PAGES_BUILDER_UI, err->message);
+
+  builder_usec = bench_builder (ui);
+  manifest_usec = bench_manifest ();
+
+  g_print ("{\n"
+           "  \"iterations\": %d,\n"
+           "  \"builder-usec\": %" G_GINT64_FORMAT ",\n"
+           "  \"manifest-usec\": %" G_GINT64_FORMAT "\n"
+           "}\n",
+           ITERATIONS, builder_usec, manifest_usec);
+
+  return 0;
+}
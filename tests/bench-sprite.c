@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-image-loader.h"
+#include "pt-sprite-paintable.h"
+
+#include <adwaita.h>
+
+#include <time.h>
+
+/*
+ * Compare the CPU time and number of repaints of an animated page
+ * illustration while paused and while playing. For reference also
+ * measure the naive approach of rendering the SVG on every frame.
+ */
+
+#define IMAGE_PATH "/mobi/phosh/PhoshTour/pages/show-keyboard.svg"
+#define IMAGE_URI "resource://" IMAGE_PATH
+#define DURATION_MS 2000
+
+typedef struct {
+  gint64 cpu_usec;
+  guint  invalidations;
+} BenchResult;
+
+
+static gint64
+get_cpu_time (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return (gint64) ts.tv_sec * G_USEC_PER_SEC + ts.tv_nsec / 1000;
+}
+
+
+static void
+on_invalidate_contents (guint *invalidations)
+{
+  (*invalidations)++;
+}
+
+
+static gboolean
+on_svg_tick (GtkWidget *picture, GdkFrameClock *frame_clock, gpointer user_data)
+{
+  GBytes *bytes = user_data;
+  g_autoptr (GdkTexture) texture = NULL;
+  g_autoptr (GError) err = NULL;
+
+  texture = gdk_texture_new_from_bytes (bytes, &err);
+  if (texture == NULL)
+    g_error ("Failed to render %s: %s", IMAGE_PATH, err->message);
+  gtk_picture_set_paintable (GTK_PICTURE (picture), GDK_PAINTABLE (texture));
+
+  return G_SOURCE_CONTINUE;
+}
+
+
+static void
+on_image_loaded (GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  GdkPaintable **paintable = user_data;
+  g_autoptr (GError) err = NULL;
+
+  *paintable = pt_image_loader_load_finish (res, &err);
+  if (*paintable == NULL)
+    g_error ("Failed to load %s: %s", IMAGE_URI, err->message);
+}
+
+
+static gboolean
+on_timeout (gpointer user_data)
+{
+  gboolean *done = user_data;
+
+  *done = TRUE;
+  return G_SOURCE_REMOVE;
+}
+
+
+static void
+run (guint ms)
+{
+  gboolean done = FALSE;
+
+  g_timeout_add (ms, on_timeout, &done);
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+
+static BenchResult
+bench (PtSpritePaintable *sprite, GtkWidget *picture, gboolean playing)
+{
+  BenchResult result = { 0 };
+  gint64 start;
+  gulong id;
+
+  if (playing)
+    pt_sprite_paintable_play (sprite, picture);
+
+  id = g_signal_connect_swapped (sprite,
+                                 "invalidate-contents",
+                                 G_CALLBACK (on_invalidate_contents),
+                                 &result.invalidations);
+  start = get_cpu_time ();
+  run (DURATION_MS);
+  result.cpu_usec = get_cpu_time () - start;
+  g_signal_handler_disconnect (sprite, id);
+
+  pt_sprite_paintable_stop (sprite);
+
+  return result;
+}
+
+
+/* Renders the SVG anew on every frame */
+static BenchResult
+bench_svg (GtkWidget *picture)
+{
+  g_autoptr (GBytes) bytes = NULL;
+  BenchResult result = { 0 };
+  GdkFrameClock *frame_clock;
+  gint64 start, frame_counter;
+  guint id;
+
+  bytes = g_resources_lookup_data (IMAGE_PATH, G_RESOURCE_LOOKUP_FLAGS_NONE, NULL);
+  if (bytes == NULL)
+    g_error ("No %s in resources", IMAGE_PATH);
+
+  frame_clock = gtk_widget_get_frame_clock (picture);
+  frame_counter = gdk_frame_clock_get_frame_counter (frame_clock);
+  id = gtk_widget_add_tick_callback (picture, on_svg_tick, bytes, NULL);
+  start = get_cpu_time ();
+  run (DURATION_MS);
+  result.cpu_usec = get_cpu_time () - start;
+  gtk_widget_remove_tick_callback (picture, id);
+  result.invalidations = gdk_frame_clock_get_frame_counter (frame_clock) - frame_counter;
+
+  return result;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_autoptr (GdkPaintable) paintable = NULL;
+  GtkWidget *window, *picture;
+  BenchResult paused, playing, svg;
+
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  pt_image_loader_load_async (IMAGE_URI, 1, NULL, on_image_loaded, &paintable);
+  while (paintable == NULL)
+    g_main_context_iteration (NULL, TRUE);
+
+  if (!PT_IS_SPRITE_PAINTABLE (paintable)) {
+    g_print ("{ \"skipped\": \"no sprite sheet for %s\" }\n", IMAGE_URI);
+    return 0;
+  }
+
+  picture = gtk_picture_new_for_paintable (paintable);
+  window = gtk_window_new ();
+  gtk_window_set_default_size (GTK_WINDOW (window), 360, 720);
+  gtk_window_set_child (GTK_WINDOW (window), picture);
+  gtk_window_present (GTK_WINDOW (window));
+  /* Let the first frame settle */
+  run (500);
+
+  paused = bench (PT_SPRITE_PAINTABLE (paintable), picture, FALSE);
+  playing = bench (PT_SPRITE_PAINTABLE (paintable), picture, TRUE);
+  svg = bench_svg (picture);
+
+  g_print ("{\n"
+           "  \"duration-ms\": %d,\n"
+           "  \"sheet-bytes\": %" G_GSIZE_FORMAT ",\n"
+           "  \"paused-cpu-usec\": %" G_GINT64_FORMAT ",\n"
+           "  \"paused-invalidations\": %u,\n"
+           "  \"playing-cpu-usec\": %" G_GINT64_FORMAT ",\n"
+           "  \"playing-invalidations\": %u,\n"
+           "  \"svg-per-frame-cpu-usec\": %" G_GINT64_FORMAT ",\n"
+           "  \"svg-per-frame-frames\": %u\n"
+           "}\n",
+           DURATION_MS,
+           pt_image_loader_get_paintable_size (paintable),
+           paused.cpu_usec, paused.invalidations,
+           playing.cpu_usec, playing.invalidations,
+           svg.cpu_usec, svg.invalidations);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+
+  return 0;
+}
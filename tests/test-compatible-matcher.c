@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-compatible-matcher.h"
+
+static const char *const librem5[] = { "purism,librem5r4", "purism,librem5", NULL };
+static const char *const pinephone[] = { "pine64,pinephone-1.2", "pine64,pinephone",
+                                         "allwinner,sun50i-a64", NULL };
+static const char *const oneplus[] = { "oneplus,enchilada", "qcom,sdm845", NULL };
+
+
+static void
+test_compatible_matcher_exact (void)
+{
+  const char *patterns[] = { "purism,librem5", NULL };
+
+  g_assert_true (pt_compatible_matcher_match_one (patterns, librem5));
+  g_assert_false (pt_compatible_matcher_match_one (patterns, pinephone));
+  /* No partial matches without a wildcard */
+  g_assert_false (pt_compatible_matcher_match_one ((const char *[]) { "purism,librem", NULL },
+                                                   librem5));
+}
+
+
+static void
+test_compatible_matcher_prefix (void)
+{
+  const char *patterns[] = { "pine64,*", NULL };
+
+  g_assert_true (pt_compatible_matcher_match_one (patterns, pinephone));
+  g_assert_false (pt_compatible_matcher_match_one (patterns, librem5));
+  g_assert_false (pt_compatible_matcher_match_one (patterns, oneplus));
+  /* The prefix itself matches too */
+  g_assert_true (pt_compatible_matcher_match_one (patterns,
+                                                  (const char *[]) { "pine64,", NULL }));
+  g_assert_false (pt_compatible_matcher_match_one (patterns,
+                                                   (const char *[]) { "pine64", NULL }));
+}
+
+
+static void
+test_compatible_matcher_negation (void)
+{
+  const char *patterns[] = { "pine64,*", "!pine64,pinephone-1.2", NULL };
+
+  /* The negation wins over the matching prefix */
+  g_assert_false (pt_compatible_matcher_match_one (patterns, pinephone));
+  g_assert_true (pt_compatible_matcher_match_one (patterns,
+                                                  (const char *[]) { "pine64,pinetab2", NULL }));
+  g_assert_false (pt_compatible_matcher_match_one (patterns, librem5));
+}
+
+
+static void
+test_compatible_matcher_negation_only (void)
+{
+  const char *patterns[] = { "!purism,*", NULL };
+
+  g_assert_false (pt_compatible_matcher_match_one (patterns, librem5));
+  g_assert_true (pt_compatible_matcher_match_one (patterns, pinephone));
+  g_assert_true (pt_compatible_matcher_match_one (patterns, oneplus));
+}
+
+
+static void
+test_compatible_matcher_empty (void)
+{
+  const char *patterns[] = { "pine64,*", NULL };
+  const char *negated[] = { "!purism,librem5", NULL };
+  const char *empty[] = { NULL };
+
+  /* A device without compatibles only matches negation-only rules */
+  g_assert_false (pt_compatible_matcher_match_one (patterns, empty));
+  g_assert_false (pt_compatible_matcher_match_one (patterns, NULL));
+  g_assert_true (pt_compatible_matcher_match_one (negated, empty));
+  g_assert_true (pt_compatible_matcher_match_one (negated, NULL));
+
+  /* Rules without patterns never match */
+  g_assert_false (pt_compatible_matcher_match_one (empty, librem5));
+  g_assert_false (pt_compatible_matcher_match_one (NULL, librem5));
+  g_assert_false (pt_compatible_matcher_match_one (NULL, NULL));
+}
+
+
+static void
+test_compatible_matcher_many_rules (void)
+{
+  g_autoptr (PtCompatibleMatcher) matcher = pt_compatible_matcher_new ();
+  guint exact, prefix, negated, negation_only, other;
+
+  exact = pt_compatible_matcher_add_rule (matcher,
+                                          (const char *[]) { "pine64,pinephone", NULL });
+  prefix = pt_compatible_matcher_add_rule (matcher, (const char *[]) { "pine64,*", NULL });
+  negated = pt_compatible_matcher_add_rule (matcher,
+                                            (const char *[]) { "pine64,*",
+                                                               "!allwinner,sun50i-a64",
+                                                               NULL });
+  negation_only = pt_compatible_matcher_add_rule (matcher,
+                                                  (const char *[]) { "!purism,librem5", NULL });
+  other = pt_compatible_matcher_add_rule (matcher, (const char *[]) { "purism,*", NULL });
+
+  pt_compatible_matcher_match (matcher, pinephone);
+  g_assert_true (pt_compatible_matcher_get_result (matcher, exact));
+  g_assert_true (pt_compatible_matcher_get_result (matcher, prefix));
+  g_assert_false (pt_compatible_matcher_get_result (matcher, negated));
+  g_assert_true (pt_compatible_matcher_get_result (matcher, negation_only));
+  g_assert_false (pt_compatible_matcher_get_result (matcher, other));
+
+  /* Matching again starts from scratch */
+  pt_compatible_matcher_match (matcher, librem5);
+  g_assert_false (pt_compatible_matcher_get_result (matcher, exact));
+  g_assert_false (pt_compatible_matcher_get_result (matcher, prefix));
+  g_assert_false (pt_compatible_matcher_get_result (matcher, negated));
+  g_assert_false (pt_compatible_matcher_get_result (matcher, negation_only));
+  g_assert_true (pt_compatible_matcher_get_result (matcher, other));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/phosh-tour/compatible-matcher/exact", test_compatible_matcher_exact);
+  g_test_add_func ("/phosh-tour/compatible-matcher/prefix", test_compatible_matcher_prefix);
+  g_test_add_func ("/phosh-tour/compatible-matcher/negation",
+                   test_compatible_matcher_negation);
+  g_test_add_func ("/phosh-tour/compatible-matcher/negation-only",
+                   test_compatible_matcher_negation_only);
+  g_test_add_func ("/phosh-tour/compatible-matcher/empty", test_compatible_matcher_empty);
+  g_test_add_func ("/phosh-tour/compatible-matcher/many-rules",
+                   test_compatible_matcher_many_rules);
+
+  return g_test_run ();
+}
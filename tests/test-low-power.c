@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-low-power.h"
+
+/*
+ * Emulate the power profiles daemon on a private bus and check that
+ * low power mode follows the active profile.
+ */
+
+#define POWER_PROFILES_BUS_NAME    "net.hadess.PowerProfiles"
+#define POWER_PROFILES_OBJECT_PATH "/net/hadess/PowerProfiles"
+#define POWER_PROFILES_INTERFACE   "net.hadess.PowerProfiles"
+
+static const char introspection_xml[] =
+  "<node>"
+  "  <interface name='" POWER_PROFILES_INTERFACE "'>"
+  "    <property name='ActiveProfile' type='s' access='readwrite'/>"
+  "  </interface>"
+  "</node>";
+
+static GDBusConnection *connection;
+static char *profile;
+
+
+static GVariant *
+get_property (GDBusConnection *conn,
+              const char      *sender,
+              const char      *object_path,
+              const char      *interface_name,
+              const char      *property_name,
+              GError         **error,
+              gpointer         user_data)
+{
+  return g_variant_new_string (profile);
+}
+
+
+static const GDBusInterfaceVTable vtable = {
+  .get_property = get_property,
+};
+
+
+static void
+set_profile (const char *new_profile, gboolean notify)
+{
+  g_autoptr (GVariantBuilder) changed = g_variant_builder_new (G_VARIANT_TYPE_VARDICT);
+  g_autoptr (GError) err = NULL;
+
+  g_free (profile);
+  profile = g_strdup (new_profile);
+  if (!notify)
+    return;
+
+  g_variant_builder_add (changed, "{sv}", "ActiveProfile", g_variant_new_string (profile));
+  g_dbus_connection_emit_signal (connection,
+                                 NULL,
+                                 POWER_PROFILES_OBJECT_PATH,
+                                 "org.freedesktop.DBus.Properties",
+                                 "PropertiesChanged",
+                                 g_variant_new ("(sa{sv}as)", POWER_PROFILES_INTERFACE, changed, NULL),
+                                 &err);
+  g_assert_no_error (err);
+}
+
+
+static void
+wait_for_active (PtLowPower *low_power, gboolean active)
+{
+  gint64 timeout = g_get_monotonic_time () + 5 * G_USEC_PER_SEC;
+
+  while (pt_low_power_get_active (low_power) != active && g_get_monotonic_time () < timeout)
+    g_main_context_iteration (NULL, FALSE);
+
+  g_assert_cmpint (pt_low_power_get_active (low_power), ==, active);
+}
+
+
+static void
+setup_power_profiles (void)
+{
+  g_autoptr (GDBusNodeInfo) info = NULL;
+  g_autoptr (GVariant) ret = NULL;
+  g_autoptr (GError) err = NULL;
+
+  connection = g_bus_get_sync (G_BUS_TYPE_SYSTEM, NULL, &err);
+  g_assert_no_error (err);
+  /* The stand-in's bus goes away before the process exits */
+  g_dbus_connection_set_exit_on_close (connection, FALSE);
+
+  info = g_dbus_node_info_new_for_xml (introspection_xml, &err);
+  g_assert_no_error (err);
+  g_dbus_connection_register_object (connection,
+                                     POWER_PROFILES_OBJECT_PATH,
+                                     info->interfaces[0],
+                                     &vtable,
+                                     NULL,
+                                     NULL,
+                                     &err);
+  g_assert_no_error (err);
+
+  ret = g_dbus_connection_call_sync (connection,
+                                     "org.freedesktop.DBus",
+                                     "/org/freedesktop/DBus",
+                                     "org.freedesktop.DBus",
+                                     "RequestName",
+                                     g_variant_new ("(su)", POWER_PROFILES_BUS_NAME, 0),
+                                     G_VARIANT_TYPE ("(u)"),
+                                     G_DBUS_CALL_FLAGS_NONE,
+                                     -1, NULL, &err);
+  g_assert_no_error (err);
+}
+
+
+static void
+test_low_power_profile (void)
+{
+  g_autoptr (PtLowPower) low_power = NULL;
+
+  set_profile ("balanced", FALSE);
+  low_power = pt_low_power_new (FALSE, NULL);
+  wait_for_active (low_power, FALSE);
+
+  set_profile ("power-saver", TRUE);
+  wait_for_active (low_power, TRUE);
+
+  set_profile ("performance", TRUE);
+  wait_for_active (low_power, FALSE);
+}
+
+
+static void
+test_low_power_initial (void)
+{
+  g_autoptr (PtLowPower) low_power = NULL;
+
+  set_profile ("power-saver", FALSE);
+  low_power = pt_low_power_new (FALSE, NULL);
+  wait_for_active (low_power, TRUE);
+}
+
+
+static void
+test_low_power_forced (void)
+{
+  g_autoptr (PtLowPower) low_power = NULL;
+
+  set_profile ("balanced", FALSE);
+  low_power = pt_low_power_new (TRUE, NULL);
+  g_assert_true (pt_low_power_get_active (low_power));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_autoptr (GTestDBus) bus = NULL;
+  int ret;
+
+  g_test_init (&argc, &argv, NULL);
+
+  bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  g_test_dbus_up (bus);
+  /* Read by GLib when the system bus is first used */
+  g_setenv ("DBUS_SYSTEM_BUS_ADDRESS", g_test_dbus_get_bus_address (bus), TRUE);
+  setup_power_profiles ();
+
+  g_test_add_func ("/phosh-tour/low-power/profile", test_low_power_profile);
+  g_test_add_func ("/phosh-tour/low-power/initial", test_low_power_initial);
+  g_test_add_func ("/phosh-tour/low-power/forced", test_low_power_forced);
+
+  ret = g_test_run ();
+
+  g_clear_object (&connection);
+  g_clear_pointer (&profile, g_free);
+  g_test_dbus_down (bus);
+
+  return ret;
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-page.h"
+#include "pt-window.h"
+
+#include <adwaita.h>
+
+#include <float.h>
+
+/*
+ * Flip through all pages forward and backward and measure the time
+ * from triggering navigation until the next frame got painted. Fails
+ * if any step exceeds the latency budget. Also check that jumping
+ * to a page by its id doesn't build the pages in between and that
+ * jumping to the current page doesn't leave a transition behind.
+ */
+
+/* Generous enough for software rendering on CI machines */
+#define DEFAULT_LATENCY_BUDGET_MS 100
+
+typedef struct {
+  PtWindow    *window;
+  AdwCarousel *carousel;
+  gint64       triggered;
+  gint64       latency;
+  gboolean     page_changed;
+  GArray      *latencies;
+} Fixture;
+
+typedef void (*NavigateFunc) (Fixture *fixture, int direction);
+
+
+static void
+on_after_paint (GdkFrameClock *frame_clock, Fixture *fixture)
+{
+  if (fixture->triggered == 0 || fixture->latency)
+    return;
+
+  fixture->latency = g_get_monotonic_time () - fixture->triggered;
+}
+
+
+static void
+on_page_changed (Fixture *fixture)
+{
+  fixture->page_changed = TRUE;
+}
+
+
+static void
+fixture_setup (Fixture *fixture, gconstpointer unused)
+{
+  GdkFrameClock *frame_clock;
+
+  fixture->window = g_object_new (PT_TYPE_WINDOW, NULL);
+  fixture->carousel = ADW_CAROUSEL (gtk_widget_get_template_child (GTK_WIDGET (fixture->window),
+                                                                   PT_TYPE_WINDOW,
+                                                                   "main_carousel"));
+  fixture->latencies = g_array_new (FALSE, FALSE, sizeof (gint64));
+  g_signal_connect_swapped (fixture->carousel, "page-changed",
+                            G_CALLBACK (on_page_changed), fixture);
+
+  gtk_window_present (GTK_WINDOW (fixture->window));
+  while (!gtk_widget_get_mapped (GTK_WIDGET (fixture->window)))
+    g_main_context_iteration (NULL, TRUE);
+
+  frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (fixture->window));
+  g_signal_connect (frame_clock, "after-paint", G_CALLBACK (on_after_paint), fixture);
+
+  /* Don't account the initial frame to the first step */
+  fixture->triggered = g_get_monotonic_time ();
+  while (fixture->latency == 0)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+
+static void
+fixture_teardown (Fixture *fixture, gconstpointer unused)
+{
+  GdkFrameClock *frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (fixture->window));
+
+  g_signal_handlers_disconnect_by_data (frame_clock, fixture);
+  gtk_window_destroy (GTK_WINDOW (fixture->window));
+  g_array_unref (fixture->latencies);
+}
+
+
+static void
+navigate_action (Fixture *fixture, int direction)
+{
+  gtk_widget_activate_action (GTK_WIDGET (fixture->window), "win.flip-page", "i", direction);
+}
+
+
+static GtkShortcut *
+find_shortcut (GtkWidget *widget, GtkShortcutTrigger *trigger, GtkWidget **owner)
+{
+  g_autoptr (GListModel) controllers = gtk_widget_observe_controllers (widget);
+
+  for (guint i = 0; i < g_list_model_get_n_items (controllers); i++) {
+    g_autoptr (GtkEventController) controller = g_list_model_get_item (controllers, i);
+
+    if (!GTK_IS_SHORTCUT_CONTROLLER (controller))
+      continue;
+
+    for (guint j = 0; j < g_list_model_get_n_items (G_LIST_MODEL (controller)); j++) {
+      g_autoptr (GtkShortcut) shortcut = g_list_model_get_item (G_LIST_MODEL (controller), j);
+
+      if (gtk_shortcut_trigger_equal (gtk_shortcut_get_trigger (shortcut), trigger)) {
+        *owner = widget;
+        return shortcut;
+      }
+    }
+  }
+
+  for (GtkWidget *child = gtk_widget_get_first_child (widget);
+       child;
+       child = gtk_widget_get_next_sibling (child)) {
+    GtkShortcut *shortcut = find_shortcut (child, trigger, owner);
+
+    if (shortcut)
+      return shortcut;
+  }
+
+  return NULL;
+}
+
+
+static void
+navigate_shortcut (Fixture *fixture, int direction)
+{
+  g_autoptr (GtkShortcutTrigger) trigger = NULL;
+  GtkShortcut *shortcut;
+  GtkWidget *owner = NULL;
+
+  trigger = gtk_shortcut_trigger_parse_string (direction > 0 ? "<Shift>Right|l" : "<Shift>Left|h");
+  shortcut = find_shortcut (GTK_WIDGET (fixture->window), trigger, &owner);
+  g_assert_nonnull (shortcut);
+
+  gtk_shortcut_action_activate (gtk_shortcut_get_action (shortcut),
+                                GTK_SHORTCUT_ACTION_EXCLUSIVE,
+                                owner,
+                                NULL);
+}
+
+
+static void
+navigate_scroll (Fixture *fixture, int direction)
+{
+  int pos = adw_carousel_get_position (fixture->carousel) + 0.5;
+  GtkWidget *page = adw_carousel_get_nth_page (fixture->carousel, pos + direction);
+
+  /* Like a finished swipe: the carousel animates to the new page */
+  adw_carousel_scroll_to (fixture->carousel, page, TRUE);
+}
+
+
+static void
+step (Fixture *fixture, NavigateFunc navigate, int direction)
+{
+  int expected = adw_carousel_get_position (fixture->carousel) + 0.5 + direction;
+
+  fixture->latency = 0;
+  fixture->page_changed = FALSE;
+  fixture->triggered = g_get_monotonic_time ();
+
+  navigate (fixture, direction);
+
+  while (!fixture->page_changed || fixture->latency == 0)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpfloat_with_epsilon (adw_carousel_get_position (fixture->carousel), expected, DBL_EPSILON);
+  g_array_append_val (fixture->latencies, fixture->latency);
+}
+
+
+static void
+test_navigation (Fixture *fixture, gconstpointer data)
+{
+  NavigateFunc navigate = (NavigateFunc) data;
+  guint n_pages = adw_carousel_get_n_pages (fixture->carousel);
+  const char *env = g_getenv ("PT_LATENCY_BUDGET_MS");
+  gint64 budget = DEFAULT_LATENCY_BUDGET_MS;
+  gint64 max = 0, sum = 0;
+
+  if (env)
+    budget = g_ascii_strtoll (env, NULL, 10);
+
+  g_assert_cmpint (n_pages, >, 1);
+
+  for (guint i = 0; i < n_pages - 1; i++)
+    step (fixture, navigate, 1);
+  for (guint i = 0; i < n_pages - 1; i++)
+    step (fixture, navigate, -1);
+
+  for (guint i = 0; i < fixture->latencies->len; i++) {
+    gint64 latency = g_array_index (fixture->latencies, gint64, i);
+
+    max = MAX (max, latency);
+    sum += latency;
+  }
+  g_test_message ("%u steps, mean latency %" G_GINT64_FORMAT " usec, max %" G_GINT64_FORMAT " usec",
+                  fixture->latencies->len, sum / fixture->latencies->len, max);
+
+  g_assert_cmpint (max, <=, budget * 1000);
+}
+
+
+static void
+assert_skipped_pages (AdwCarousel *carousel, int target)
+{
+  g_assert_cmpfloat_with_epsilon (adw_carousel_get_position (carousel), target, DBL_EPSILON);
+
+  /* Only the first page, the target and their neighbours are built */
+  for (int i = 2; i < target - 1; i++)
+    g_assert_false (pt_page_is_materialized (PT_PAGE (adw_carousel_get_nth_page (carousel, i))));
+  g_assert_true (pt_page_is_materialized (PT_PAGE (adw_carousel_get_nth_page (carousel, target))));
+}
+
+
+static void
+test_navigation_goto_page (Fixture *fixture, gconstpointer unused)
+{
+  int n_pages = adw_carousel_get_n_pages (fixture->carousel);
+
+  fixture->page_changed = FALSE;
+  gtk_widget_activate_action (GTK_WIDGET (fixture->window), "win.goto-page", "s", "all-set");
+  while (!fixture->page_changed)
+    g_main_context_iteration (NULL, TRUE);
+
+  assert_skipped_pages (fixture->carousel, n_pages - 1);
+}
+
+
+static gboolean
+on_settle_timeout (gpointer user_data)
+{
+  gboolean *done = user_data;
+
+  *done = TRUE;
+  return G_SOURCE_REMOVE;
+}
+
+
+static void
+test_navigation_goto_current_page (Fixture *fixture, gconstpointer unused)
+{
+  GtkWidget *first = adw_carousel_get_nth_page (fixture->carousel, 0);
+  gboolean done = FALSE;
+
+  g_assert_cmpfloat_with_epsilon (adw_carousel_get_position (fixture->carousel), 0, DBL_EPSILON);
+
+  gtk_widget_activate_action (GTK_WIDGET (fixture->window), "win.goto-page", "s",
+                              pt_page_get_page_id (PT_PAGE (first)));
+  /* Nothing moves so there's no signal to wait for */
+  g_timeout_add (250, on_settle_timeout, &done);
+  while (!done)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_cmpfloat_with_epsilon (adw_carousel_get_position (fixture->carousel), 0, DBL_EPSILON);
+  for (guint i = 0; i < adw_carousel_get_n_pages (fixture->carousel); i++) {
+    PtPage *page = PT_PAGE (adw_carousel_get_nth_page (fixture->carousel, i));
+
+    g_assert_false (pt_page_get_cache_snapshot (page));
+  }
+}
+
+
+static void
+test_navigation_initial_page (void)
+{
+  PtWindow *window;
+  AdwCarousel *carousel;
+  int n_pages;
+
+  window = g_object_new (PT_TYPE_WINDOW, "initial-page", "all-set", NULL);
+  carousel = ADW_CAROUSEL (gtk_widget_get_template_child (GTK_WIDGET (window),
+                                                          PT_TYPE_WINDOW,
+                                                          "main_carousel"));
+  n_pages = adw_carousel_get_n_pages (carousel);
+  g_assert_false (pt_page_is_materialized (PT_PAGE (adw_carousel_get_nth_page (carousel, 0))));
+
+  gtk_window_present (GTK_WINDOW (window));
+  while (!gtk_widget_get_mapped (GTK_WIDGET (window)))
+    g_main_context_iteration (NULL, TRUE);
+  while (g_main_context_pending (NULL))
+    g_main_context_iteration (NULL, FALSE);
+
+  assert_skipped_pages (carousel, n_pages - 1);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add ("/phosh-tour/navigation/action", Fixture, (gconstpointer) navigate_action,
+              fixture_setup, test_navigation, fixture_teardown);
+  g_test_add ("/phosh-tour/navigation/shortcut", Fixture, (gconstpointer) navigate_shortcut,
+              fixture_setup, test_navigation, fixture_teardown);
+  g_test_add ("/phosh-tour/navigation/scroll", Fixture, (gconstpointer) navigate_scroll,
+              fixture_setup, test_navigation, fixture_teardown);
+  g_test_add ("/phosh-tour/navigation/goto-page", Fixture, NULL,
+              fixture_setup, test_navigation_goto_page, fixture_teardown);
+  g_test_add ("/phosh-tour/navigation/goto-current-page", Fixture, NULL,
+              fixture_setup, test_navigation_goto_current_page, fixture_teardown);
+  g_test_add_func ("/phosh-tour/navigation/initial-page", test_navigation_initial_page);
+
+  return g_test_run ();
+}
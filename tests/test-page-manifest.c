@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-page.h"
+#include "pt-page-manifest.h"
+
+#include <adwaita.h>
+
+/*
+ * The ids run-once records must be exactly those of the pages that
+ * get built, otherwise pages are shown as new or marked as seen
+ * without ever being shown.
+ */
+
+
+static void
+test_page_manifest_page_ids (void)
+{
+  g_autoptr (GPtrArray) pages = NULL;
+  g_auto (GStrv) ids = NULL;
+  g_autoptr (GError) err = NULL;
+
+  ids = pt_page_manifest_get_page_ids (&err);
+  g_assert_no_error (err);
+  g_assert_nonnull (ids);
+
+  pages = pt_page_manifest_build_pages (&err);
+  g_assert_no_error (err);
+  g_assert_nonnull (pages);
+
+  g_assert_cmpuint (g_strv_length (ids), ==, pages->len);
+  for (guint i = 0; i < pages->len; i++)
+    g_assert_cmpstr (ids[i], ==, pt_page_get_page_id (g_ptr_array_index (pages, i)));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add_func ("/phosh-tour/page-manifest/page-ids", test_page_manifest_page_ids);
+
+  return g_test_run ();
+}
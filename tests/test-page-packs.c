@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-pack-page.h"
+#include "pt-page.h"
+#include "pt-page-packs.h"
+
+#include <adwaita.h>
+#include <glib/gstdio.h>
+
+/*
+ * Merge page packs into a set of built-in pages and check the
+ * resulting order, that page definitions are only read when
+ * materialized and that the index picks up changes.
+ */
+
+static const char *const builtin_ids[] = { "welcome", "go-home", "all-set", NULL };
+
+typedef struct {
+  char      *dir;
+  char      *index_path;
+  GPtrArray *pages;
+} Fixture;
+
+
+static void
+write_page (Fixture *fixture, const char *name, const char *contents)
+{
+  g_autofree char *path = g_build_filename (fixture->dir, name, NULL);
+  g_autoptr (GError) err = NULL;
+
+  g_file_set_contents (path, contents, -1, &err);
+  g_assert_no_error (err);
+}
+
+
+static char *
+get_page_ids (Fixture *fixture)
+{
+  g_autoptr (GStrvBuilder) builder = g_strv_builder_new ();
+  g_auto (GStrv) ids = NULL;
+
+  for (guint i = 0; i < fixture->pages->len; i++)
+    g_strv_builder_add (builder, pt_page_get_page_id (g_ptr_array_index (fixture->pages, i)));
+
+  ids = g_strv_builder_end (builder);
+  return g_strjoinv (" ", ids);
+}
+
+
+static void
+reset_pages (Fixture *fixture)
+{
+  g_clear_pointer (&fixture->pages, g_ptr_array_unref);
+  fixture->pages = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (int i = 0; builtin_ids[i]; i++) {
+    PtPage *page = g_object_new (PT_TYPE_PAGE, "page-id", builtin_ids[i], NULL);
+
+    g_ptr_array_add (fixture->pages, g_object_ref_sink (page));
+  }
+}
+
+
+static void
+fixture_setup (Fixture *fixture, gconstpointer unused)
+{
+  g_autoptr (GError) err = NULL;
+
+  fixture->dir = g_dir_make_tmp ("phosh-tour-packs-XXXXXX", &err);
+  g_assert_no_error (err);
+  fixture->index_path = g_build_filename (fixture->dir, "index", "page-packs.gvariant", NULL);
+  reset_pages (fixture);
+}
+
+
+static void
+fixture_teardown (Fixture *fixture, gconstpointer unused)
+{
+  g_autoptr (GDir) dir = g_dir_open (fixture->dir, 0, NULL);
+  g_autofree char *index_dir = g_path_get_dirname (fixture->index_path);
+  const char *name;
+
+  g_unlink (fixture->index_path);
+  g_rmdir (index_dir);
+  while ((name = g_dir_read_name (dir))) {
+    g_autofree char *path = g_build_filename (fixture->dir, name, NULL);
+
+    g_unlink (path);
+  }
+  g_rmdir (fixture->dir);
+
+  g_clear_pointer (&fixture->pages, g_ptr_array_unref);
+  g_clear_pointer (&fixture->index_path, g_free);
+  g_clear_pointer (&fixture->dir, g_free);
+}
+
+
+static void
+test_page_packs_order (Fixture *fixture, gconstpointer unused)
+{
+  g_autofree char *ids = NULL;
+
+  write_page (fixture, "10-new.page", "[Page]\nId=new\nSummary=New\n");
+  write_page (fixture, "20-first.page", "[Page]\nId=first\nSummary=First\nBefore=welcome\n");
+  write_page (fixture, "30-move.page", "[Page]\nId=go-home\nAfter=all-set\n");
+  write_page (fixture, "40-hide.page", "[Page]\nId=welcome\nHidden=true\n");
+  write_page (fixture, "50-other.page", "[Page]\nId=other\nSummary=Other\nCompatibles=no,such-device;\n");
+  write_page (fixture, "README", "Not a page\n");
+
+  pt_page_packs_merge (fixture->pages, fixture->dir, fixture->index_path);
+
+  ids = get_page_ids (fixture);
+  g_assert_cmpstr (ids, ==, "first new all-set go-home");
+  g_assert_true (g_file_test (fixture->index_path, G_FILE_TEST_EXISTS));
+}
+
+
+static void
+test_page_packs_lazy (Fixture *fixture, gconstpointer unused)
+{
+  g_autofree char *summary = NULL;
+  g_autofree char *image_uri = NULL;
+  g_autofree char *expected_uri = NULL;
+  g_autofree char *image_path = NULL;
+  PtPage *page;
+
+  write_page (fixture, "replace.page",
+              "[Page]\nId=go-home\nSummary=Replaced\nImage=go-home.svg\n");
+
+  pt_page_packs_merge (fixture->pages, fixture->dir, fixture->index_path);
+
+  g_assert_cmpuint (fixture->pages->len, ==, 3);
+  page = g_ptr_array_index (fixture->pages, 1);
+  g_assert_true (PT_IS_PACK_PAGE (page));
+  g_assert_cmpstr (pt_page_get_page_id (page), ==, "go-home");
+
+  /* Nothing but the index is read until the page is materialized */
+  g_object_get (page, "summary", &summary, "image-uri", &image_uri, NULL);
+  g_assert_null (summary);
+  g_assert_null (image_uri);
+
+  pt_page_materialize (page);
+  g_object_get (page, "summary", &summary, "image-uri", &image_uri, NULL);
+  g_assert_cmpstr (summary, ==, "Replaced");
+  image_path = g_build_filename (fixture->dir, "go-home.svg", NULL);
+  expected_uri = g_filename_to_uri (image_path, NULL, NULL);
+  g_assert_cmpstr (image_uri, ==, expected_uri);
+}
+
+
+static void
+test_page_packs_index (Fixture *fixture, gconstpointer unused)
+{
+  g_autofree char *ids = NULL;
+
+  write_page (fixture, "a.page", "[Page]\nId=a\nSummary=A\n");
+  pt_page_packs_merge (fixture->pages, fixture->dir, fixture->index_path);
+  ids = get_page_ids (fixture);
+  g_assert_cmpstr (ids, ==, "welcome go-home a all-set");
+  g_clear_pointer (&ids, g_free);
+
+  /* Unchanged directory, the index is used as is */
+  reset_pages (fixture);
+  pt_page_packs_merge (fixture->pages, fixture->dir, fixture->index_path);
+  ids = get_page_ids (fixture);
+  g_assert_cmpstr (ids, ==, "welcome go-home a all-set");
+  g_clear_pointer (&ids, g_free);
+
+  /* Modified page */
+  write_page (fixture, "a.page", "[Page]\nId=a\nSummary=A\nBefore=welcome\n");
+  reset_pages (fixture);
+  pt_page_packs_merge (fixture->pages, fixture->dir, fixture->index_path);
+  ids = get_page_ids (fixture);
+  g_assert_cmpstr (ids, ==, "a welcome go-home all-set");
+  g_clear_pointer (&ids, g_free);
+
+  /* Added page */
+  write_page (fixture, "b.page", "[Page]\nId=b\nSummary=B\nAfter=all-set\n");
+  reset_pages (fixture);
+  pt_page_packs_merge (fixture->pages, fixture->dir, fixture->index_path);
+  ids = get_page_ids (fixture);
+  g_assert_cmpstr (ids, ==, "a welcome go-home all-set b");
+}
+
+
+static void
+test_page_packs_no_dir (Fixture *fixture, gconstpointer unused)
+{
+  g_autofree char *dir = g_build_filename (fixture->dir, "does-not-exist", NULL);
+  g_autofree char *ids = NULL;
+
+  pt_page_packs_merge (fixture->pages, dir, fixture->index_path);
+
+  ids = get_page_ids (fixture);
+  g_assert_cmpstr (ids, ==, "welcome go-home all-set");
+  g_assert_false (g_file_test (fixture->index_path, G_FILE_TEST_EXISTS));
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  gtk_test_init (&argc, &argv, NULL);
+  adw_init ();
+
+  g_test_add ("/phosh-tour/page-packs/order", Fixture, NULL,
+              fixture_setup, test_page_packs_order, fixture_teardown);
+  g_test_add ("/phosh-tour/page-packs/lazy", Fixture, NULL,
+              fixture_setup, test_page_packs_lazy, fixture_teardown);
+  g_test_add ("/phosh-tour/page-packs/index", Fixture, NULL,
+              fixture_setup, test_page_packs_index, fixture_teardown);
+  g_test_add ("/phosh-tour/page-packs/no-dir", Fixture, NULL,
+              fixture_setup, test_page_packs_no_dir, fixture_teardown);
+
+  return g_test_run ();
+}
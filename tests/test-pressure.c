@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-pressure.h"
+
+#include <glib/gstdio.h>
+
+typedef struct {
+  char *dir;
+} Fixture;
+
+
+static void
+write_pressure (const char *dir, double cpu, double io, double memory)
+{
+  const char *resources[] = { "cpu", "io", "memory" };
+  double values[] = { cpu, io, memory };
+
+  for (guint i = 0; i < G_N_ELEMENTS (resources); i++) {
+    g_autofree char *path = g_build_filename (dir, resources[i], NULL);
+    g_autofree char *contents = NULL;
+    g_autoptr (GError) err = NULL;
+    char value[G_ASCII_DTOSTR_BUF_SIZE];
+
+    /* Locale independent like the kernel's */
+    g_ascii_formatd (value, sizeof (value), "%.2f", values[i]);
+    contents = g_strdup_printf ("some avg10=%s avg60=1.00 avg300=0.50 total=12345\n"
+                                "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n",
+                                value);
+    g_file_set_contents (path, contents, -1, &err);
+    g_assert_no_error (err);
+  }
+}
+
+
+static void
+fixture_setup (Fixture *fixture, gconstpointer unused)
+{
+  g_autoptr (GError) err = NULL;
+
+  fixture->dir = g_dir_make_tmp ("phosh-tour-pressure-XXXXXX", &err);
+  g_assert_no_error (err);
+}
+
+
+static void
+fixture_teardown (Fixture *fixture, gconstpointer unused)
+{
+  const char *resources[] = { "cpu", "io", "memory" };
+
+  for (guint i = 0; i < G_N_ELEMENTS (resources); i++) {
+    g_autofree char *path = g_build_filename (fixture->dir, resources[i], NULL);
+
+    g_unlink (path);
+  }
+  g_rmdir (fixture->dir);
+  g_free (fixture->dir);
+}
+
+
+static void
+test_pressure_read (Fixture *fixture, gconstpointer unused)
+{
+  g_autoptr (GError) err = NULL;
+  PtPressure pressure;
+
+  write_pressure (fixture->dir, 12.5, 3.25, 0.0);
+
+  g_assert_true (pt_pressure_read (fixture->dir, &pressure, &err));
+  g_assert_no_error (err);
+  g_assert_cmpfloat_with_epsilon (pressure.cpu, 12.5, 0.001);
+  g_assert_cmpfloat_with_epsilon (pressure.io, 3.25, 0.001);
+  g_assert_cmpfloat_with_epsilon (pressure.memory, 0.0, 0.001);
+}
+
+
+static void
+test_pressure_missing (Fixture *fixture, gconstpointer unused)
+{
+  const PtPressure thresholds = { 1.0, 1.0, 1.0 };
+  g_autoptr (GError) err = NULL;
+  PtPressure pressure;
+
+  g_assert_false (pt_pressure_read (fixture->dir, &pressure, &err));
+  g_assert_error (err, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+
+  /* Without PSI there's nothing to wait for */
+  g_assert_true (pt_pressure_wait (fixture->dir, &thresholds, 10, 60000));
+}
+
+
+static void
+test_pressure_exceeds (void)
+{
+  const PtPressure thresholds = { 20.0, 10.0, 5.0 };
+  const PtPressure low = { 19.0, 9.0, 4.0 };
+  const PtPressure high_io = { 1.0, 10.5, 1.0 };
+
+  g_assert_false (pt_pressure_exceeds (&low, &thresholds));
+  g_assert_true (pt_pressure_exceeds (&high_io, &thresholds));
+  g_assert_false (pt_pressure_exceeds (&thresholds, &thresholds));
+}
+
+
+static void
+test_pressure_wait_timeout (Fixture *fixture, gconstpointer unused)
+{
+  const PtPressure thresholds = { 20.0, 10.0, 5.0 };
+  gint64 start;
+
+  write_pressure (fixture->dir, 50.0, 0.0, 0.0);
+
+  start = g_get_monotonic_time ();
+  g_assert_false (pt_pressure_wait (fixture->dir, &thresholds, 10, 100));
+  g_assert_cmpint (g_get_monotonic_time () - start, >=, 100 * 1000);
+}
+
+
+static gpointer
+settle_thread (gpointer user_data)
+{
+  /* Let the waiter see high pressure first */
+  g_usleep (50 * 1000);
+  write_pressure (user_data, 1.0, 1.0, 1.0);
+
+  return NULL;
+}
+
+
+static void
+test_pressure_wait_settles (Fixture *fixture, gconstpointer unused)
+{
+  const PtPressure thresholds = { 20.0, 10.0, 5.0 };
+  GThread *thread;
+  gint64 start;
+
+  write_pressure (fixture->dir, 0.0, 0.0, 40.0);
+
+  /* Drop pressure from another thread while waiting */
+  thread = g_thread_new ("settle", settle_thread, fixture->dir);
+
+  start = g_get_monotonic_time ();
+  g_assert_true (pt_pressure_wait (fixture->dir, &thresholds, 10, 60000));
+  g_assert_cmpint (g_get_monotonic_time () - start, <, 60000 * 1000);
+
+  g_thread_join (thread);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add ("/phosh-tour/pressure/read", Fixture, NULL,
+              fixture_setup, test_pressure_read, fixture_teardown);
+  g_test_add ("/phosh-tour/pressure/missing", Fixture, NULL,
+              fixture_setup, test_pressure_missing, fixture_teardown);
+  g_test_add_func ("/phosh-tour/pressure/exceeds", test_pressure_exceeds);
+  g_test_add ("/phosh-tour/pressure/wait-timeout", Fixture, NULL,
+              fixture_setup, test_pressure_wait_timeout, fixture_teardown);
+  g_test_add ("/phosh-tour/pressure/wait-settles", Fixture, NULL,
+              fixture_setup, test_pressure_wait_settles, fixture_teardown);
+
+  return g_test_run ();
+}
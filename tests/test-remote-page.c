@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "phosh-tour-config.h"
+
+#include "pt-application.h"
+#include "pt-window.h"
+
+#include <adwaita.h>
+
+#include <float.h>
+
+/*
+ * Run the tour on a private session bus, launch a second instance
+ * with --page and check that the running tour moves to that page.
+ */
+
+
+static void
+on_remote_exited (GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+  gboolean *done = user_data;
+  g_autoptr (GError) err = NULL;
+
+  g_subprocess_wait_check_finish (G_SUBPROCESS (source_object), res, &err);
+  g_assert_no_error (err);
+  *done = TRUE;
+}
+
+
+static void
+test_remote_page (void)
+{
+  g_autoptr (PtApplication) app = NULL;
+  g_autoptr (GSubprocess) remote = NULL;
+  g_autoptr (GError) err = NULL;
+  GtkWindow *window;
+  AdwCarousel *carousel;
+  gboolean done = FALSE;
+  gint64 timeout;
+  int last;
+
+  app = pt_application_new (PHOSH_TOUR_APP_ID, G_APPLICATION_DEFAULT_FLAGS);
+  g_application_register (G_APPLICATION (app), NULL, &err);
+  g_assert_no_error (err);
+  g_assert_false (g_application_get_is_remote (G_APPLICATION (app)));
+  /* Don't exit when the bus goes away on shutdown */
+  g_dbus_connection_set_exit_on_close (g_application_get_dbus_connection (G_APPLICATION (app)), FALSE);
+
+  g_application_activate (G_APPLICATION (app));
+  window = gtk_application_get_active_window (GTK_APPLICATION (app));
+  g_assert_nonnull (window);
+  carousel = ADW_CAROUSEL (gtk_widget_get_template_child (GTK_WIDGET (window),
+                                                          PT_TYPE_WINDOW,
+                                                          "main_carousel"));
+  while (!gtk_widget_get_mapped (GTK_WIDGET (window)))
+    g_main_context_iteration (NULL, TRUE);
+  g_assert_cmpfloat_with_epsilon (adw_carousel_get_position (carousel), 0.0, DBL_EPSILON);
+
+  remote = g_subprocess_new (G_SUBPROCESS_FLAGS_NONE, &err, PT_PHOSH_TOUR, "--page=all-set", NULL);
+  g_assert_no_error (err);
+  g_subprocess_wait_check_async (remote, NULL, on_remote_exited, &done);
+
+  last = adw_carousel_get_n_pages (carousel) - 1;
+  timeout = g_get_monotonic_time () + 10 * G_USEC_PER_SEC;
+  while ((!done || !G_APPROX_VALUE (adw_carousel_get_position (carousel), (double) last, DBL_EPSILON)) &&
+         g_get_monotonic_time () < timeout) {
+    g_main_context_iteration (NULL, FALSE);
+  }
+
+  g_assert_true (done);
+  g_assert_cmpfloat_with_epsilon (adw_carousel_get_position (carousel), last, DBL_EPSILON);
+
+  gtk_window_destroy (window);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  GTestDBus *bus;
+  int ret;
+
+  g_test_init (&argc, &argv, NULL);
+
+  /* Sets DBUS_SESSION_BUS_ADDRESS for us and the second instance */
+  bus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  g_test_dbus_up (bus);
+
+  g_test_add_func ("/phosh-tour/remote-page/goto", test_remote_page);
+
+  ret = g_test_run ();
+
+  /* The toolkit may keep the session bus connection alive so don't
+   * wait for it to go away like g_test_dbus_down () would */
+  g_test_dbus_stop (bus);
+
+  return ret;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Phosh Developers
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "pt-stamp.h"
+
+#include <glib/gstdio.h>
+
+
+static void
+test_stamp_roundtrip (void)
+{
+  const char *const page_ids[] = { "welcome", "go-home", "all-set", NULL };
+  g_autofree char *dir = NULL;
+  g_autofree char *path = NULL;
+  g_autofree char *version = NULL;
+  g_auto (GStrv) seen = NULL;
+  g_autoptr (GError) err = NULL;
+  gboolean success;
+
+  dir = g_dir_make_tmp ("phosh-tour-stamp-XXXXXX", &err);
+  g_assert_no_error (err);
+  path = g_build_filename (dir, "phosh-tour", "run-once", NULL);
+
+  success = pt_stamp_load (path, &version, &seen, &err);
+  g_assert_error (err, G_FILE_ERROR, G_FILE_ERROR_NOENT);
+  g_assert_false (success);
+  g_clear_error (&err);
+
+  success = pt_stamp_save (path, "1.0", page_ids, &err);
+  g_assert_no_error (err);
+  g_assert_true (success);
+
+  success = pt_stamp_load (path, &version, &seen, &err);
+  g_assert_no_error (err);
+  g_assert_true (success);
+  g_assert_cmpstr (version, ==, "1.0");
+  g_assert_cmpstrv (seen, page_ids);
+
+  g_unlink (path);
+  g_clear_pointer (&path, g_free);
+  path = g_build_filename (dir, "phosh-tour", NULL);
+  g_rmdir (path);
+  g_rmdir (dir);
+}
+
+
+static void
+test_stamp_legacy (void)
+{
+  g_autofree char *path = NULL;
+  g_autofree char *version = NULL;
+  g_auto (GStrv) seen = NULL;
+  g_autoptr (GError) err = NULL;
+
+  path = g_test_build_filename (G_TEST_DIST, "data", "config", "phosh-tour", "run-once", NULL);
+  g_assert_true (pt_stamp_load (path, &version, &seen, &err));
+  g_assert_no_error (err);
+
+  /* Stamps without page ids cover the pages that existed back then */
+  g_assert_null (version);
+  g_assert_true (g_strv_contains ((const char *const *) seen, "welcome"));
+  g_assert_true (g_strv_contains ((const char *const *) seen, "all-set"));
+}
+
+
+static void
+test_stamp_unseen (void)
+{
+  const char *const seen[] = { "welcome", "go-home", "gone", "all-set", NULL };
+  const char *const page_ids[] = { "welcome", "new", "go-home", "all-set", "other", NULL };
+  const char *const expected[] = { "new", "other", NULL };
+  g_auto (GStrv) unseen = NULL;
+
+  unseen = pt_stamp_get_unseen_pages (seen, page_ids);
+  g_assert_cmpstrv (unseen, expected);
+
+  g_clear_pointer (&unseen, g_strfreev);
+  unseen = pt_stamp_get_unseen_pages (page_ids, page_ids);
+  g_assert_cmpuint (g_strv_length (unseen), ==, 0);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  g_test_add_func ("/phosh-tour/stamp/roundtrip", test_stamp_roundtrip);
+  g_test_add_func ("/phosh-tour/stamp/legacy", test_stamp_legacy);
+  g_test_add_func ("/phosh-tour/stamp/unseen", test_stamp_unseen);
+
+  return g_test_run ();
+}